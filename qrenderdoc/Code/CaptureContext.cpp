@@ -834,6 +834,9 @@ void CaptureContext::LoadCaptureThreaded(const QString &captureFile, const Repla
 
     m_Drawcalls = &r->GetDrawcalls();
 
+    m_DrawcallLookup.clear();
+    AddDrawcallLookups(*m_Drawcalls);
+
     m_FirstDrawcall = &m_Drawcalls->at(0);
     while(!m_FirstDrawcall->children.empty())
       m_FirstDrawcall = &m_FirstDrawcall->children[0];
@@ -982,6 +985,23 @@ void CaptureContext::LoadCaptureThreaded(const QString &captureFile, const Repla
   m_CaptureLoaded = true;
 }
 
+void CaptureContext::AddDrawcallLookups(const rdcarray<DrawcallDescription> &draws)
+{
+  for(const DrawcallDescription &d : draws)
+  {
+    // markers can share an eventId with other drawcalls. Children are added before their parent and
+    // the first one added wins, the same as the order the tree used to be searched in.
+    if(!d.children.empty())
+      AddDrawcallLookups(d.children);
+
+    if(d.eventId >= m_DrawcallLookup.size())
+      m_DrawcallLookup.resize(d.eventId + 1);
+
+    if(m_DrawcallLookup[d.eventId] == NULL)
+      m_DrawcallLookup[d.eventId] = &d;
+  }
+}
+
 void CaptureContext::CacheResources()
 {
   m_Resources.clear();
@@ -1238,6 +1258,7 @@ void CaptureContext::CloseCapture()
   m_Notes.clear();
 
   m_Drawcalls = &m_EmptyDraws;
+  m_DrawcallLookup.clear();
   m_FirstDrawcall = m_LastDrawcall = NULL;
 
   m_CurD3D11PipelineState = NULL;
@@ -169,7 +169,7 @@ public:
   const rdcarray<BufferDescription> &GetBuffers() override { return m_BufferList; }
   const DrawcallDescription *GetDrawcall(uint32_t eventId) override
   {
-    return GetDrawcall(*m_Drawcalls, eventId);
+    return eventId < m_DrawcallLookup.size() ? m_DrawcallLookup[eventId] : NULL;
   }
   const SDFile &GetStructuredFile() override { return *m_StructuredFile; }
   WindowingSystem CurWindowingSystem() override { return m_CurWinSystem; }
@@ -315,23 +315,11 @@ private:
   uint32_t m_SelectedEventID = 0;
   uint32_t m_EventID = 0;
 
-  const DrawcallDescription *GetDrawcall(const rdcarray<DrawcallDescription> &draws, uint32_t eventId)
-  {
-    for(const DrawcallDescription &d : draws)
-    {
-      if(!d.children.empty())
-      {
-        const DrawcallDescription *draw = GetDrawcall(d.children, eventId);
-        if(draw != NULL)
-          return draw;
-      }
-
-      if(d.eventId == eventId)
-        return &d;
-    }
+  void AddDrawcallLookups(const rdcarray<DrawcallDescription> &draws);
 
-    return NULL;
-  }
+  // drawcalls and markers indexed by eventId, so that looking one up doesn't walk the whole tree.
+  // Built once when a capture is loaded.
+  rdcarray<const DrawcallDescription *> m_DrawcallLookup;
 
   void setupDockWindow(QWidget *shad);
   const rdcarray<DrawcallDescription> *m_Drawcalls;
@@ -485,6 +485,145 @@ struct TypeConversion<rdcpair<A, B>, false>
   static PyObject *ConvertToPy(const rdcpair<A, B> &in) { return ConvertToPy(in, NULL); }
 };
 
+// python object that owns a bytebuf and exports it with the buffer protocol. Byte data is returned
+// to python as a memoryview over one of these, so it can be sliced, unpacked with struct or passed
+// to numpy without copying it again.
+struct PyBufferOwner
+{
+  PyObject_HEAD;
+  bytebuf *data;
+};
+
+inline int PyBufferOwner_getbuffer(PyObject *self, Py_buffer *view, int flags)
+{
+  bytebuf *data = ((PyBufferOwner *)self)->data;
+  return PyBuffer_FillInfo(view, self, data->data(), (Py_ssize_t)data->size(), 0, flags);
+}
+
+inline void PyBufferOwner_dealloc(PyObject *self)
+{
+  PyBufferOwner *owner = (PyBufferOwner *)self;
+  delete owner->data;
+  Py_TYPE(self)->tp_free(self);
+}
+
+inline PyTypeObject *PyBufferOwner_Type()
+{
+  static PyTypeObject type = {PyVarObject_HEAD_INIT(NULL, 0)};
+  static PyBufferProcs bufferProcs = {};
+
+  if(type.tp_name == NULL)
+  {
+    bufferProcs.bf_getbuffer = &PyBufferOwner_getbuffer;
+
+    type.tp_name = "renderdoc.BufferOwner";
+    type.tp_basicsize = sizeof(PyBufferOwner);
+    type.tp_flags = Py_TPFLAGS_DEFAULT;
+    type.tp_doc = "Owns the memory behind a memoryview returned from the renderdoc module";
+    type.tp_dealloc = &PyBufferOwner_dealloc;
+    type.tp_as_buffer = &bufferProcs;
+
+    if(PyType_Ready(&type) < 0)
+    {
+      type.tp_name = NULL;
+      return NULL;
+    }
+  }
+
+  return &type;
+}
+
+// takes the contents of data, leaving it empty, and returns a memoryview over them. If format is
+// specified the memoryview is cast to that struct-module format to view it as an array of elements.
+inline PyObject *TakeIntoMemoryView(bytebuf &data, const char *format = NULL)
+{
+  PyTypeObject *type = PyBufferOwner_Type();
+  if(!type)
+    return NULL;
+
+  PyBufferOwner *owner = PyObject_New(PyBufferOwner, type);
+  if(!owner)
+    return NULL;
+
+  owner->data = new bytebuf;
+  owner->data->swap(data);
+
+  // the memoryview holds the only reference to the owner once we release ours
+  PyObject *view = PyMemoryView_FromObject((PyObject *)owner);
+  Py_DecRef((PyObject *)owner);
+
+  if(view && format)
+  {
+    PyObject *cast = PyObject_CallMethod(view, "cast", "s", format);
+    Py_DecRef(view);
+    view = cast;
+  }
+
+  return view;
+}
+
+// struct-module format for element types that can be viewed directly in a memoryview
+template <typename T>
+struct BufferFormat
+{
+  static const char *Get() { return NULL; }
+};
+
+#define BUFFER_FORMAT(type, fmt)              \
+  template <>                                 \
+  struct BufferFormat<type>                   \
+  {                                           \
+    static const char *Get() { return fmt; } \
+  };
+
+BUFFER_FORMAT(uint8_t, "B");
+BUFFER_FORMAT(int8_t, "b");
+BUFFER_FORMAT(uint16_t, "H");
+BUFFER_FORMAT(int16_t, "h");
+BUFFER_FORMAT(uint32_t, "I");
+BUFFER_FORMAT(int32_t, "i");
+BUFFER_FORMAT(uint64_t, "Q");
+BUFFER_FORMAT(int64_t, "q");
+BUFFER_FORMAT(float, "f");
+BUFFER_FORMAT(double, "d");
+
+#undef BUFFER_FORMAT
+
+// copies the contents of any C-contiguous object supporting the buffer protocol, such as bytes,
+// bytearray, memoryview or a numpy array. If elemSize is non-zero the exporter's items must be
+// that size.
+inline int ConvertBufferFromPy(PyObject *in, void *&outData, size_t &outSize, size_t elemSize,
+                               bytebuf &storage)
+{
+  if(!PyObject_CheckBuffer(in))
+    return SWIG_TypeError;
+
+  Py_buffer view = {};
+  if(PyObject_GetBuffer(in, &view, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) != 0)
+  {
+    PyErr_Clear();
+    return SWIG_TypeError;
+  }
+
+  int ret = SWIG_OK;
+
+  if(elemSize != 0 && (size_t)view.itemsize != elemSize)
+  {
+    ret = SWIG_TypeError;
+  }
+  else
+  {
+    storage.resize((size_t)view.len);
+    memcpy(storage.data(), view.buf, storage.size());
+    outData = storage.data();
+    outSize = storage.size();
+  }
+
+  PyBuffer_Release(&view);
+
+  return ret;
+}
+
 // specialisation for bytebuf
 template <>
 struct TypeConversion<bytebuf, false>
@@ -493,32 +632,44 @@ struct TypeConversion<bytebuf, false>
   // nicer failure error messages out with the index that failed
   static int ConvertFromPy(PyObject *in, bytebuf &out, int *failIdx)
   {
-    if(!PyBytes_Check(in))
-      return SWIG_TypeError;
+    if(PyBytes_Check(in))
+    {
+      Py_ssize_t len = PyBytes_Size(in);
 
-    Py_ssize_t len = PyBytes_Size(in);
+      out.resize((size_t)len);
+      memcpy(out.data(), PyBytes_AsString(in), out.size());
 
-    out.resize((size_t)len);
-    memcpy(out.data(), PyBytes_AsString(in), out.size());
+      return SWIG_OK;
+    }
 
-    return SWIG_OK;
+    // accept anything else that exports its memory, so bytes returned as memoryviews can be passed
+    // straight back
+    void *data = NULL;
+    size_t size = 0;
+    return ConvertBufferFromPy(in, data, size, 0, out);
   }
 
   static int ConvertFromPy(PyObject *in, bytebuf &out) { return ConvertFromPy(in, out, NULL); }
   static PyObject *ConvertToPyInPlace(PyObject *list, const bytebuf &in, int *failIdx)
   {
-    // can't modify bytes objects
+    // can't modify memoryview objects
     return SWIG_Py_Void();
   }
 
   static PyObject *ConvertToPy(const bytebuf &in, int *failIdx)
   {
-    return PyBytes_FromStringAndSize((const char *)in.data(), (Py_ssize_t)in.size());
+    bytebuf copy = in;
+    return TakeIntoMemoryView(copy);
   }
 
   static PyObject *ConvertToPy(const bytebuf &in) { return ConvertToPy(in, NULL); }
+  // used for bytebufs returned by value, which are temporaries we can take without a copy
+  static PyObject *ConvertToPyTake(bytebuf &in) { return TakeIntoMemoryView(in); }
 };
 
+// arrays of plain values at least this long are returned as memoryviews instead of lists
+static const int LazyArrayThreshold = 4096;
+
 // specialisation for array
 template <typename U>
 struct TypeConversion<rdcarray<U>, false>
@@ -540,6 +691,18 @@ struct TypeConversion<rdcarray<U>, false>
   // nicer failure error messages out with the index that failed
   static int ConvertFromPy(PyObject *in, rdcarray<U> &out, int *failIdx)
   {
+    // arrays of plain values can come back from python as the memoryviews we returned them in
+    if(!PyList_Check(in) && BufferFormat<U>::Get())
+    {
+      bytebuf storage;
+      void *data = NULL;
+      size_t size = 0;
+      int ret = ConvertBufferFromPy(in, data, size, sizeof(U), storage);
+      if(SWIG_IsOK(ret))
+        out.assign((const U *)data, size / sizeof(U));
+      return ret;
+    }
+
     if(!PyList_Check(in))
       return SWIG_TypeError;
 
@@ -586,6 +749,18 @@ struct TypeConversion<rdcarray<U>, false>
 
   static PyObject *ConvertToPy(const rdcarray<U> &in, int *failIdx)
   {
+    // large arrays of plain values are returned as a typed memoryview, which converts elements only
+    // as they're accessed instead of creating a python object for each one up front. Smaller arrays
+    // stay as lists since that's more convenient to work with.
+    const char *format = BufferFormat<U>::Get();
+    if(format && in.count() >= LazyArrayThreshold)
+    {
+      bytebuf bytes;
+      bytes.resize(in.size() * sizeof(U));
+      memcpy(bytes.data(), in.data(), bytes.size());
+      return TakeIntoMemoryView(bytes, format);
+    }
+
     PyObject *list = PyList_New(0);
     if(!list)
       return NULL;
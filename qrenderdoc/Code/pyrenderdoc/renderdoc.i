@@ -176,6 +176,11 @@ SIMPLE_TYPEMAPS(rdcstr)
 SIMPLE_TYPEMAPS(rdcdatetime)
 SIMPLE_TYPEMAPS(bytebuf)
 
+// bytebufs returned by value are temporaries, so hand their storage straight to python
+%typemap(out) bytebuf {
+  $result = TypeConversion<bytebuf>::ConvertToPyTake($1);
+}
+
 FIXED_ARRAY_TYPEMAPS(ResourceId)
 FIXED_ARRAY_TYPEMAPS(double)
 FIXED_ARRAY_TYPEMAPS(float)
@@ -294,6 +299,7 @@ TEMPLATE_ARRAY_INSTANTIATE(rdcarray, PixelModification)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, ResourceDescription)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, ResourceId)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, LineColumnInfo)
+TEMPLATE_ARRAY_INSTANTIATE(rdcarray, MeshFormat)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, ShaderCompileFlag)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, ShaderConstant)
 TEMPLATE_ARRAY_INSTANTIATE(rdcarray, ShaderDebugState)
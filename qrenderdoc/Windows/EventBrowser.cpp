@@ -254,6 +254,8 @@ void EventBrowser::OnCaptureLoaded()
 
   ui->events->expandItem(frame);
 
+  AddEventNodeLookups(frame);
+
   clearBookmarks();
   repopulateBookmarks();
 
@@ -272,6 +274,9 @@ void EventBrowser::OnCaptureClosed()
 
   on_HideFindJump();
 
+  m_EventNodes.clear();
+  m_ExactEventNodes.clear();
+
   ui->events->clear();
 
   ui->find->setEnabled(false);
@@ -1071,8 +1076,7 @@ void EventBrowser::repopulateBookmarks()
 
       highlightBookmarks();
 
-      RDTreeWidgetItem *found = NULL;
-      FindEventNode(found, ui->events->topLevelItem(0), EID);
+      RDTreeWidgetItem *found = FindEventNode(EID);
 
       if(found)
       {
@@ -1096,8 +1100,7 @@ void EventBrowser::repopulateBookmarks()
       delete m_BookmarkButtons[EID];
       m_BookmarkButtons.remove(EID);
 
-      RDTreeWidgetItem *found = NULL;
-      FindEventNode(found, ui->events->topLevelItem(0), EID);
+      RDTreeWidgetItem *found = FindEventNode(EID);
 
       if(found)
       {
@@ -1168,32 +1171,39 @@ void EventBrowser::RefreshIcon(RDTreeWidgetItem *item, EventItemTag tag)
     item->setIcon(COL_NAME, QIcon());
 }
 
-bool EventBrowser::FindEventNode(RDTreeWidgetItem *&found, RDTreeWidgetItem *parent, uint32_t eventId)
+void EventBrowser::AddEventNodeLookups(RDTreeWidgetItem *parent)
 {
-  // do a reverse search to find the last match (in case of 'set' markers that
-  // inherit the event of the next real draw).
+  // nodes are visited in reverse, so where several share an eventId - like 'set' markers that
+  // inherit the event of the next real draw - the earliest in the tree is last.
   for(int i = parent->childCount() - 1; i >= 0; i--)
   {
     RDTreeWidgetItem *n = parent->child(i);
 
-    uint nEID = n->tag().value<EventItemTag>().lastEID;
-    uint fEID = found ? found->tag().value<EventItemTag>().lastEID : 0;
+    uint32_t eid = n->tag().value<EventItemTag>().lastEID;
 
-    if(nEID >= eventId && (found == NULL || nEID <= fEID))
-      found = n;
+    m_EventNodes[eid] = n;
 
-    if(nEID == eventId && n->childCount() == 0)
-      return true;
+    // a draw with exactly the eventId being searched for is preferred over any marker region
+    if(n->childCount() == 0 && !m_ExactEventNodes.contains(eid))
+      m_ExactEventNodes[eid] = n;
 
     if(n->childCount() > 0)
-    {
-      bool exact = FindEventNode(found, n, eventId);
-      if(exact)
-        return true;
-    }
+      AddEventNodeLookups(n);
   }
+}
 
-  return false;
+RDTreeWidgetItem *EventBrowser::FindEventNode(uint32_t eventId)
+{
+  auto exact = m_ExactEventNodes.find(eventId);
+  if(exact != m_ExactEventNodes.end())
+    return exact.value();
+
+  // otherwise the node that contains the event, which is the first to end at or after it
+  auto it = m_EventNodes.lowerBound(eventId);
+  if(it != m_EventNodes.end())
+    return it.value();
+
+  return NULL;
 }
 
 void EventBrowser::ExpandNode(RDTreeWidgetItem *node)
@@ -1214,8 +1224,7 @@ bool EventBrowser::SelectEvent(uint32_t eventId)
   if(!m_Ctx.IsCaptureLoaded())
     return false;
 
-  RDTreeWidgetItem *found = NULL;
-  FindEventNode(found, ui->events->topLevelItem(0), eventId);
+  RDTreeWidgetItem *found = FindEventNode(eventId);
   if(found != NULL)
   {
     ui->events->setCurrentItem(found);
@@ -102,7 +102,8 @@ private:
 
   void ExpandNode(RDTreeWidgetItem *node);
 
-  bool FindEventNode(RDTreeWidgetItem *&found, RDTreeWidgetItem *parent, uint32_t eventId);
+  void AddEventNodeLookups(RDTreeWidgetItem *parent);
+  RDTreeWidgetItem *FindEventNode(uint32_t eventId);
   bool SelectEvent(uint32_t eventId);
 
   void ClearFindIcons(RDTreeWidgetItem *parent);
@@ -139,6 +140,11 @@ private:
   QSpacerItem *m_BookmarkSpacer;
   QMap<uint32_t, QToolButton *> m_BookmarkButtons;
 
+  // tree nodes by the last eventId they contain, built once when the capture is loaded so that
+  // selecting an event doesn't search the whole tree.
+  QMap<uint32_t, RDTreeWidgetItem *> m_EventNodes;
+  QMap<uint32_t, RDTreeWidgetItem *> m_ExactEventNodes;
+
   void RefreshIcon(RDTreeWidgetItem *item, EventItemTag tag);
 
   Ui::EventBrowser *ui;
@@ -22,6 +22,8 @@
  * THE SOFTWARE.
  ******************************************************************************/
 
+#pragma once
+
 // this file exists just to wrap the *real* catch.hpp and define any configuration defines we always
 // want on.
 
@@ -213,6 +213,26 @@ typedef enum RENDERDOC_CaptureOption {
   // necessary as directed by a RenderDoc developer.
   eRENDERDOC_Option_AllowUnsupportedVendorExtensions = 12,
 
+  // Keep the most recent frames in memory so they can be written out as a capture after the fact,
+  // with TriggerRetroactiveCapture(). This is opt-in as it means the application is always
+  // capturing, with a periodic stall to snapshot resource contents.
+  //
+  // NOTE: This is currently only supported on Vulkan.
+  //
+  // Default - 0
+  //
+  // 0 - Retroactive capture is disabled
+  // N - Up to N frames are held in memory. A snapshot of resource contents is taken at least
+  //     every N frames, and a retroactive capture contains the frames since the last snapshot.
+  eRENDERDOC_Option_RetroactiveCaptureFrames = 13,
+
+  // The most memory in megabytes that frames held for retroactive capture can use, including the
+  // snapshot of resource contents they start from. When this is exceeded a new snapshot is taken
+  // early and the older frames are dropped.
+  //
+  // Default - 256
+  eRENDERDOC_Option_RetroactiveCaptureMemoryMB = 14,
+
 } RENDERDOC_CaptureOption;
 
 // Sets an option that controls how RenderDoc behaves on capture.
@@ -520,6 +540,21 @@ typedef uint32_t(RENDERDOC_CC *pRENDERDOC_EndFrameCapture)(RENDERDOC_DevicePoint
 typedef uint32_t(RENDERDOC_CC *pRENDERDOC_DiscardFrameCapture)(RENDERDOC_DevicePointer device,
                                                                RENDERDOC_WindowHandle wndHandle);
 
+// Writes out the frames held in memory for retroactive capture as a single capture, at the next
+// present. See eRENDERDOC_Option_RetroactiveCaptureFrames.
+//
+// This will return 1 if retroactive capture is enabled, and 0 if it isn't
+typedef uint32_t(RENDERDOC_CC *pRENDERDOC_TriggerRetroactiveCapture)();
+
+// Returns the current cost of retroactive capture. Any parameter may be NULL.
+//
+// numFrames is filled with the number of frames currently held in memory, which would be written
+// out by TriggerRetroactiveCapture(). memoryBytes is filled with the memory they use, and
+// snapshotMilliseconds with how long the application was stalled for the most recent snapshot.
+typedef void(RENDERDOC_CC *pRENDERDOC_GetRetroactiveCaptureStats)(uint32_t *numFrames,
+                                                                  uint64_t *memoryBytes,
+                                                                  float *snapshotMilliseconds);
+
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // RenderDoc API versions
 //
@@ -543,6 +578,7 @@ typedef enum RENDERDOC_Version {
   eRENDERDOC_API_Version_1_2_0 = 10200,    // RENDERDOC_API_1_2_0 = 1 02 00
   eRENDERDOC_API_Version_1_3_0 = 10300,    // RENDERDOC_API_1_3_0 = 1 03 00
   eRENDERDOC_API_Version_1_4_0 = 10400,    // RENDERDOC_API_1_4_0 = 1 04 00
+  eRENDERDOC_API_Version_1_5_0 = 10500,    // RENDERDOC_API_1_5_0 = 1 05 00
 } RENDERDOC_Version;
 
 // API version changelog:
@@ -568,8 +604,12 @@ typedef enum RENDERDOC_Version {
 //         0xdddddddd of uninitialised buffer contents.
 // 1.4.0 - Added feature: DiscardFrameCapture() to discard a frame capture in progress and stop
 //         capturing without saving anything to disk.
+// 1.5.0 - Added feature: Retroactive capture, with new capture options
+//         eRENDERDOC_Option_RetroactiveCaptureFrames and
+//         eRENDERDOC_Option_RetroactiveCaptureMemoryMB, and the functions
+//         TriggerRetroactiveCapture() and GetRetroactiveCaptureStats().
 
-typedef struct RENDERDOC_API_1_4_0
+typedef struct RENDERDOC_API_1_5_0
 {
   pRENDERDOC_GetAPIVersion GetAPIVersion;
 
@@ -635,16 +675,21 @@ typedef struct RENDERDOC_API_1_4_0
 
   // new function in 1.4.0
   pRENDERDOC_DiscardFrameCapture DiscardFrameCapture;
-} RENDERDOC_API_1_4_0;
-
-typedef RENDERDOC_API_1_4_0 RENDERDOC_API_1_0_0;
-typedef RENDERDOC_API_1_4_0 RENDERDOC_API_1_0_1;
-typedef RENDERDOC_API_1_4_0 RENDERDOC_API_1_0_2;
-typedef RENDERDOC_API_1_4_0 RENDERDOC_API_1_1_0;
-typedef RENDERDOC_API_1_4_0 RENDERDOC_API_1_1_1;
-typedef RENDERDOC_API_1_4_0 RENDERDOC_API_1_1_2;
-typedef RENDERDOC_API_1_4_0 RENDERDOC_API_1_2_0;
-typedef RENDERDOC_API_1_4_0 RENDERDOC_API_1_3_0;
+
+  // new functions in 1.5.0
+  pRENDERDOC_TriggerRetroactiveCapture TriggerRetroactiveCapture;
+  pRENDERDOC_GetRetroactiveCaptureStats GetRetroactiveCaptureStats;
+} RENDERDOC_API_1_5_0;
+
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_0_0;
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_0_1;
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_0_2;
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_1_0;
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_1_1;
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_1_2;
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_2_0;
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_3_0;
+typedef RENDERDOC_API_1_5_0 RENDERDOC_API_1_4_0;
 
 //////////////////////////////////////////////////////////////////////////////////////////////////
 // RenderDoc API entry point
@@ -1339,6 +1339,40 @@ struct DriverInformation
 
 DECLARE_REFLECTION_STRUCT(DriverInformation);
 
+DOCUMENT(R"(Statistics about restoring resources to their initial contents at the start of each full
+replay of the frame.
+
+Resources that the replay knows weren't modified by anything replayed since they were last restored
+are skipped. Byte counts are estimates of the restored data and may be 0 for resources where the
+size isn't known.
+)");
+struct InitialStateRestoreStats
+{
+  DOCUMENT("");
+  InitialStateRestoreStats() = default;
+  InitialStateRestoreStats(const InitialStateRestoreStats &) = default;
+
+  DOCUMENT("The number of times initial contents have been restored since the capture was loaded.");
+  uint32_t numRestores = 0;
+
+  DOCUMENT("The number of resources that were restored in the most recent restore.");
+  uint32_t lastRestoredResources = 0;
+  DOCUMENT("The number of resources that were skipped in the most recent restore.");
+  uint32_t lastSkippedResources = 0;
+
+  DOCUMENT("The number of bytes that were restored in the most recent restore.");
+  uint64_t lastRestoredBytes = 0;
+  DOCUMENT("The number of bytes that were skipped in the most recent restore.");
+  uint64_t lastSkippedBytes = 0;
+
+  DOCUMENT("The total number of bytes restored over all restores.");
+  uint64_t totalRestoredBytes = 0;
+  DOCUMENT("The total number of bytes skipped over all restores.");
+  uint64_t totalSkippedBytes = 0;
+};
+
+DECLARE_REFLECTION_STRUCT(InitialStateRestoreStats);
+
 DOCUMENT("A 128-bit Uuid.");
 struct Uuid
 {
@@ -1677,7 +1711,7 @@ struct Thumbnail
   DOCUMENT("The :class:`FileType` of the data in the thumbnail.");
   FileType type = FileType::Raw;
 
-  DOCUMENT("The ``bytes`` byte array containing the raw data.");
+  DOCUMENT("The ``memoryview`` byte array containing the raw data.");
   bytebuf data;
 
   DOCUMENT("The width of the thumbnail image.");
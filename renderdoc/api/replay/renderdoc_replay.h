@@ -707,7 +707,7 @@ which is useful for operations like picking vertices that depends on the output
 the output data is not displayed anywhere natively.
 
 :return: The output texture data as tightly packed RGB 3-byte data.
-:rtype: ``bytes``
+:rtype: ``memoryview``
 )");
   virtual bytebuf ReadbackOutputTexture() = 0;
 
@@ -1124,6 +1124,14 @@ See :meth:`BuildTargetShader`.
 )");
   virtual FrameDescription GetFrameInfo() = 0;
 
+  DOCUMENT(R"(Retrieve statistics on how much initial state has been restored at the start of each
+replay of the frame, and how much was skipped because the replay didn't modify it.
+
+:return: The restore statistics.
+:rtype: InitialStateRestoreStats
+)");
+  virtual InitialStateRestoreStats GetInitialStateRestoreStats() = 0;
+
   DOCUMENT(R"(Fetch the structured data representation of the capture loaded.
 
 :return: The structured file.
@@ -1344,17 +1352,44 @@ texture to something compatible with the target file format.
 )");
   virtual MeshFormat GetPostVSData(uint32_t instance, uint32_t view, MeshDataStage stage) = 0;
 
-  DOCUMENT(R"(Retrieve the contents of a range of a buffer as a ``bytes``.
+  DOCUMENT(R"(Retrieve the generated data from one of the geometry processing shader stages for
+several drawcalls at once.
+
+This is equivalent to calling :meth:`SetFrameEvent` and :meth:`GetPostVSData` for each event in
+turn, but draws in the same render pass are fetched together in a single replay so it is much
+faster when processing many draws. The current event is unchanged on return.
+
+:param List[int] eventIds: The events to fetch data for. Events that aren't drawcalls will return
+  an empty :class:`MeshFormat`.
+:param int instance: The index of the instance to retrieve data for, clamped to the number of
+  instances in each drawcall.
+:param int view: The index of the multiview view to retrieve data for.
+:param MeshDataStage stage: The stage of the geometry processing pipeline to retrieve data from.
+:return: The information describing where the post-transform data is stored, in the same order as
+  ``eventIds``.
+:rtype: List[MeshFormat]
+)");
+  virtual rdcarray<MeshFormat> GetPostVSDataForEvents(const rdcarray<uint32_t> &eventIds,
+                                                      uint32_t instance, uint32_t view,
+                                                      MeshDataStage stage) = 0;
+
+  DOCUMENT(R"(Retrieve the contents of a range of a buffer.
+
+The data is returned as a ``memoryview`` which owns the contents directly, so it can be passed to
+``struct.unpack_from`` or ``numpy.frombuffer`` without a copy. Use ``bytes()`` on it if a ``bytes``
+object is needed.
 
 :param ResourceId buff: The id of the buffer to retrieve data from.
 :param int offset: The byte offset to the start of the range.
 :param int len: The length of the range, or 0 to retrieve the rest of the bytes in the buffer.
 :return: The requested buffer contents.
-:rtype: ``bytes``
+:rtype: ``memoryview``
 )");
   virtual bytebuf GetBufferData(ResourceId buff, uint64_t offset, uint64_t len) = 0;
 
-  DOCUMENT(R"(Retrieve the contents of one subresource of a texture as a ``bytes``.
+  DOCUMENT(R"(Retrieve the contents of one subresource of a texture.
+
+As with :meth:`GetBufferData` the data is returned as a ``memoryview`` that owns the contents.
 
 For multi-sampled images, they are treated as if they are an array that is Nx longer, with each
 array slice being expanded in-place so it would be slice 0: sample 0, slice 0: sample 1, slice 1:
@@ -1364,7 +1399,7 @@ sample 0, etc.
 :param int arrayIdx: The slice of an array or 3D texture, or face of a cubemap texture.
 :param int mip: The mip level to pick from.
 :return: The requested texture contents.
-:rtype: ``bytes``
+:rtype: ``memoryview``
 )");
   virtual bytebuf GetTextureData(ResourceId tex, uint32_t arrayIdx, uint32_t mip) = 0;
 
@@ -1535,7 +1570,7 @@ This index should not be cached, as writing sections could re-order the indices.
 
 :param int index: The index of the section.
 :return: The raw contents of the section, if the index is valid.
-:rtype: ``bytes``.
+:rtype: ``memoryview``.
 )");
   virtual bytebuf GetSectionContents(int index) = 0;
 
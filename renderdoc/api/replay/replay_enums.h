@@ -83,6 +83,14 @@ version of RenderDoc that addes a new section type. They should be considered eq
   lossless.
 
   The name for this section will be "renderdoc/internal/exthumb".
+
+.. data:: ShaderReflection
+
+  This section contains shader reflection data computed when the capture was first opened, so that
+  it doesn't need to be recomputed on later loads. It is only used if it was written by the same
+  version of RenderDoc, and can be safely removed.
+
+  The name for this section will be "renderdoc/internal/shaderreflection".
 )");
 enum class SectionType : uint32_t
 {
@@ -95,6 +103,7 @@ enum class SectionType : uint32_t
   ResourceRenames,
   AMDRGPProfile,
   ExtendedThumbnail,
+  ShaderReflection,
   Count,
 };
 
@@ -1009,7 +1009,7 @@ struct ShaderReflection
   DOCUMENT("The :class:`ShaderEncoding` of this shader. See :data:`rawBytes`.");
   ShaderEncoding encoding = ShaderEncoding::Unknown;
 
-  DOCUMENT(R"(A raw ``bytes`` dump of the original shader, encoded in the form denoted by
+  DOCUMENT(R"(A raw ``memoryview`` dump of the original shader, encoded in the form denoted by
 :data:`encoding`.
 )");
   bytebuf rawBytes;
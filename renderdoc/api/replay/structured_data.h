@@ -833,7 +833,7 @@ DECLARE_REFLECTION_STRUCT(StructuredChunkList);
 
 DECLARE_REFLECTION_STRUCT(bytebuf);
 
-DOCUMENT("A ``list`` of ``bytes`` objects");
+DOCUMENT("A ``list`` of ``memoryview`` objects");
 struct StructuredBufferList : public rdcarray<bytebuf *>
 {
   StructuredBufferList() : rdcarray<bytebuf *>() {}
@@ -875,7 +875,7 @@ struct SDFile
   DOCUMENT("A ``list`` of :class:`SDChunk` objects with the chunks in order.");
   StructuredChunkList chunks;
 
-  DOCUMENT("A ``list`` of serialised buffers stored as ``bytes`` objects");
+  DOCUMENT("A ``list`` of serialised buffers stored as ``memoryview`` objects");
   StructuredBufferList buffers;
 
   DOCUMENT("The version of this structured stream, typically only used internally.");
@@ -479,7 +479,7 @@ struct SpecializationConstant
   }
   DOCUMENT("The specialization ID");
   uint32_t specializationId = 0;
-  DOCUMENT("A ``bytes`` with the contents of the constant.");
+  DOCUMENT("A ``memoryview`` with the contents of the constant.");
   bytebuf data;
 };
 
@@ -1042,7 +1042,7 @@ struct State
   DOCUMENT("A :class:`VKPipeline` with the currently bound graphics pipeline, if any.");
   Pipeline graphics;
 
-  DOCUMENT("A ``bytes`` containing the raw push constant data.");
+  DOCUMENT("A ``memoryview`` containing the raw push constant data.");
   bytebuf pushconsts;
 
   DOCUMENT("A :class:`VKInputAssembly` describing the input assembly stage.");
@@ -0,0 +1,98 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+// Helpers for microbenchmarks. These are written as catch test cases tagged [!benchmark], which
+// hides them from normal unit test runs. They're run with 'renderdoccmd test bench'.
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "3rdparty/catch/catch.hpp"
+#include "common/timing.h"
+#include "os/os_specific.h"
+
+// stores through a volatile so that the compiler can't discard work whose result is unused
+inline void BenchmarkKeep(uint64_t val)
+{
+  static volatile uint64_t sink = 0;
+  sink = sink + val;
+}
+
+// Calls func repeatedly and prints the median time per call, and the throughput if bytesPerCall is
+// non-zero. Calls are grouped into batches of at least 10ms so that timer resolution doesn't
+// matter, and the median over batches discards outliers from the OS scheduling something else.
+//
+// Each result is one line with fixed columns, so that the output from different runs can be
+// compared directly:
+//   <name> <calls> <ms per call> <MB/s>
+inline void RunBenchmark(const char *name, uint64_t bytesPerCall, const std::function<void()> &func)
+{
+  const double minBatchMS = 10.0;
+  const double minTotalMS = 300.0;
+  const size_t minBatches = 5;
+  const size_t maxBatches = 50;
+
+  // warm up caches and any lazy allocation, and find how many calls make a batch
+  uint64_t batchSize = 1;
+  for(;;)
+  {
+    PerformanceTimer timer;
+    for(uint64_t i = 0; i < batchSize; i++)
+      func();
+
+    if(timer.GetMilliseconds() >= minBatchMS)
+      break;
+
+    batchSize *= 2;
+  }
+
+  std::vector<double> perCall;
+  double totalMS = 0.0;
+
+  while(perCall.size() < maxBatches && (perCall.size() < minBatches || totalMS < minTotalMS))
+  {
+    PerformanceTimer timer;
+    for(uint64_t i = 0; i < batchSize; i++)
+      func();
+
+    double ms = timer.GetMilliseconds();
+    totalMS += ms;
+    perCall.push_back(ms / double(batchSize));
+  }
+
+  std::sort(perCall.begin(), perCall.end());
+
+  double median = perCall[perCall.size() / 2];
+
+  std::string throughput = "-";
+  if(bytesPerCall > 0 && median > 0.0)
+    throughput =
+        StringFormat::Fmt("%.1f", (double(bytesPerCall) / (1024.0 * 1024.0)) / (median / 1000.0));
+
+  Catch::cout() << StringFormat::Fmt("%-60s %10llu %14.6f %12s\n", name,
+                                     (unsigned long long)(batchSize * perCall.size()), median,
+                                     throughput.c_str());
+}
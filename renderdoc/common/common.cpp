@@ -537,3 +537,44 @@ void rdclog_direct(time_t utcTime, uint32_t pid, LogType type, const char *proje
 
   SAFE_DELETE_ARRAY(oversizedBuffer);
 }
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "common/benchmark.h"
+
+TEST_CASE("Benchmark FindDiffRange", "[common][!benchmark]")
+{
+  const size_t size = 16 * 1024 * 1024;
+
+  byte *a = AllocAlignedBuffer(size);
+  byte *b = AllocAlignedBuffer(size);
+
+  for(size_t i = 0; i < size; i++)
+    a[i] = b[i] = byte(i * 13);
+
+  size_t diffStart = 0, diffEnd = 0;
+
+  // identical buffers are the worst case, both sweeps go over the whole buffer
+  RunBenchmark("FindDiffRange 16MB identical", size, [&]() {
+    BenchmarkKeep(FindDiffRange(a, b, size, diffStart, diffEnd) ? 1 : 0);
+  });
+
+  CHECK(FindDiffRange(a, b, size, diffStart, diffEnd) == false);
+
+  // a typical small map update in the middle of a large buffer
+  b[size / 2] ^= 0xff;
+  b[size / 2 + 4096] ^= 0xff;
+
+  RunBenchmark("FindDiffRange 16MB small central difference", size, [&]() {
+    BenchmarkKeep(FindDiffRange(a, b, size, diffStart, diffEnd) ? 1 : 0);
+  });
+
+  CHECK(FindDiffRange(a, b, size, diffStart, diffEnd) == true);
+  CHECK(diffStart == size / 2);
+  CHECK(diffEnd == size / 2 + 4097);
+
+  FreeAlignedBuffer(a);
+  FreeAlignedBuffer(b);
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
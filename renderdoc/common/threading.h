@@ -89,6 +89,54 @@ public:
 private:
   SpinLock *m_Spin;
 };
+
+// calls func(i) for every i in [0, count) spread over up to one thread per core, including the
+// calling thread, and returns once every call has finished. Indices are handed out one at a time so
+// uneven amounts of work still balance. func must be safe to call concurrently.
+template <typename Func>
+void ParallelFor(uint32_t count, Func func)
+{
+  uint32_t numThreads = NumberOfCores();
+  if(numThreads > count)
+    numThreads = count;
+
+  if(numThreads <= 1)
+  {
+    for(uint32_t i = 0; i < count; i++)
+      func(i);
+    return;
+  }
+
+  volatile int32_t next = -1;
+
+  auto worker = [&next, &func, count]() {
+    for(;;)
+    {
+      int32_t idx = Atomic::Inc32(&next);
+      if(idx >= (int32_t)count)
+        break;
+      func((uint32_t)idx);
+    }
+  };
+
+  std::vector<ThreadHandle> threads;
+  threads.reserve(numThreads - 1);
+  for(uint32_t t = 0; t + 1 < numThreads; t++)
+  {
+    ThreadHandle th = CreateThread(worker);
+    // if we can't create a thread the remaining ones (or this thread) pick up its work
+    if(th)
+      threads.push_back(th);
+  }
+
+  worker();
+
+  for(ThreadHandle th : threads)
+  {
+    JoinThread(th);
+    CloseThread(th);
+  }
+}
 };
 
 #define SCOPED_LOCK(cs) Threading::ScopedLock CONCAT(scopedlock, __LINE__)(&cs);
@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "common/threading.h"
+#include "common/timing.h"
 #include "os/os_specific.h"
 
 #if ENABLED(ENABLE_UNIT_TESTS)
@@ -71,4 +72,109 @@ TEST_CASE("Test spin lock", "[threading]")
   CHECK(finalValue == value);
 }
 
+TEST_CASE("Test TLS slots", "[threading]")
+{
+  uint64_t slotA = Threading::AllocateTLSSlot();
+  uint64_t slotB = Threading::AllocateTLSSlot();
+
+  CHECK(slotA != slotB);
+
+  SECTION("Values are per-thread")
+  {
+    Threading::SetTLSValue(slotA, (void *)0x1234);
+
+    CHECK(Threading::GetTLSValue(slotA) == (void *)0x1234);
+    CHECK(Threading::GetTLSValue(slotB) == NULL);
+
+    int32_t failures = 0;
+
+    std::vector<Threading::ThreadHandle> threads;
+
+    for(uintptr_t i = 0; i < 8; i++)
+    {
+      threads.push_back(Threading::CreateThread([slotA, slotB, i, &failures]() {
+        // a new thread sees nothing in slots set by other threads
+        if(Threading::GetTLSValue(slotA) != NULL)
+          Atomic::Inc32(&failures);
+
+        for(uintptr_t c = 0; c < 1000; c++)
+        {
+          Threading::SetTLSValue(slotB, (void *)(i * 10000 + c));
+          Threading::Sleep(0);
+          if(Threading::GetTLSValue(slotB) != (void *)(i * 10000 + c))
+            Atomic::Inc32(&failures);
+        }
+      }));
+    }
+
+    for(Threading::ThreadHandle t : threads)
+    {
+      Threading::JoinThread(t);
+      Threading::CloseThread(t);
+    }
+
+    CHECK(failures == 0);
+
+    // other threads didn't affect this thread's values
+    CHECK(Threading::GetTLSValue(slotA) == (void *)0x1234);
+    CHECK(Threading::GetTLSValue(slotB) == NULL);
+
+    Threading::SetTLSValue(slotA, NULL);
+  };
+
+  SECTION("Lookup overhead")
+  {
+    Threading::SetTLSValue(slotB, (void *)0x10);
+
+    const uint32_t count = 10000000;
+
+    uintptr_t sum = 0;
+
+    PerformanceTimer timer;
+
+    for(uint32_t i = 0; i < count; i++)
+      sum += (uintptr_t)Threading::GetTLSValue(slotB);
+
+    double ns = timer.GetMicroseconds() * 1000.0 / double(count);
+
+    CHECK(sum == uintptr_t(count) * 0x10);
+
+    RDCLOG("GetTLSValue: %.2f ns per call", ns);
+
+    Threading::SetTLSValue(slotB, NULL);
+  };
+}
+
+TEST_CASE("Test parallel for", "[threading]")
+{
+  SECTION("Every index is visited exactly once")
+  {
+    std::vector<int32_t> visits;
+    visits.resize(1000);
+
+    Threading::ParallelFor((uint32_t)visits.size(),
+                           [&visits](uint32_t i) { Atomic::Inc32(&visits[i]); });
+
+    for(size_t i = 0; i < visits.size(); i++)
+    {
+      INFO("index " << i);
+      CHECK(visits[i] == 1);
+    }
+  };
+
+  SECTION("Empty and single ranges")
+  {
+    int32_t calls = 0;
+
+    Threading::ParallelFor(0, [&calls](uint32_t) { Atomic::Inc32(&calls); });
+    CHECK(calls == 0);
+
+    Threading::ParallelFor(1, [&calls](uint32_t i) {
+      CHECK(i == 0);
+      Atomic::Inc32(&calls);
+    });
+    CHECK(calls == 1);
+  };
+}
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
\ No newline at end of file
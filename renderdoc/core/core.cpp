@@ -321,6 +321,9 @@ void RenderDoc::Initialise()
     {
       m_RemoteIdent = port;
 
+      m_TargetControlWakeup = new Network::Wakeup();
+      m_ControlClientWakeup = new Network::Wakeup();
+
       m_TargetControlThreadShutdown = false;
       m_RemoteThread = Threading::CreateThread([sock]() { TargetControlServerThread(sock); });
 
@@ -429,10 +432,12 @@ RenderDoc::~RenderDoc()
   if(m_RemoteThread)
   {
     m_TargetControlThreadShutdown = true;
+    m_TargetControlWakeup->Signal();
     // On windows we can't join to this thread as it could lead to deadlocks, since we're
     // performing this destructor in the middle of module unloading. However we want to
     // ensure that the thread gets properly tidied up and closes its socket, so wait a little
-    // while to give it time to notice the shutdown signal and close itself.
+    // while to give it time to notice the shutdown signal and close itself. For the same reason
+    // the wakeups can't be freed here, since the threads may still be using them.
     Threading::Sleep(50);
     Threading::CloseThread(m_RemoteThread);
     m_RemoteThread = 0;
@@ -458,10 +463,29 @@ void RenderDoc::Shutdown()
   {
     // explicitly wait for thread to shutdown, this call is not from module unloading and
     // we want to be sure everything is gone before we remove our module & hooks
+    m_TargetControlJoinClient = true;
     m_TargetControlThreadShutdown = true;
+    m_TargetControlWakeup->Signal();
     Threading::JoinThread(m_RemoteThread);
     Threading::CloseThread(m_RemoteThread);
     m_RemoteThread = 0;
+
+    if(m_ControlClientThread)
+    {
+      m_ControlClientThreadShutdown = true;
+      m_ControlClientWakeup->Signal();
+      Threading::JoinThread(m_ControlClientThread);
+      Threading::CloseThread(m_ControlClientThread);
+      m_ControlClientThread = 0;
+    }
+
+    // both threads are gone, so nothing waits on either wakeup any more.
+    SAFE_DELETE(m_TargetControlWakeup);
+
+    {
+      SCOPED_LOCK(m_ControlClientWakeupLock);
+      SAFE_DELETE(m_ControlClientWakeup);
+    }
   }
 }
 
@@ -1371,12 +1395,31 @@ void RenderDoc::AddActiveDriver(RDCDriver driver, bool present)
 
   uint64_t timestamp = present ? Timing::GetUnixTimestamp() : 0;
 
+  bool changed = false;
+
   {
     SCOPED_LOCK(m_DriverLock);
 
-    uint64_t &active = m_ActiveDrivers[driver];
-    active = RDCMAX(active, timestamp);
+    auto it = m_ActiveDrivers.find(driver);
+
+    if(it == m_ActiveDrivers.end())
+    {
+      m_ActiveDrivers[driver] = timestamp;
+      changed = true;
+    }
+    else
+    {
+      // only notify when this could change the presenting state reported by GetActiveDrivers,
+      // not on every present.
+      if(timestamp > 0 && (it->second == 0 || it->second < timestamp - 10))
+        changed = true;
+
+      it->second = RDCMAX(it->second, timestamp);
+    }
   }
+
+  if(changed)
+    NotifyTargetControl(eNotify_Drivers);
 }
 
 std::map<RDCDriver, bool> RenderDoc::GetActiveDrivers()
@@ -1407,6 +1450,41 @@ std::map<RDCDriver, bool> RenderDoc::GetActiveDrivers()
   return ret;
 }
 
+void RenderDoc::NotifyTargetControl(int32_t flags)
+{
+  int32_t prev, next;
+  do
+  {
+    prev = m_TargetControlNotify;
+    next = prev | flags;
+  } while(Atomic::CmpExch32(&m_TargetControlNotify, prev, next) != prev);
+
+  // only need to wake the thread up on the first notification since it last consumed them, any
+  // others will be picked up at the same time.
+  if(prev == 0)
+  {
+    SCOPED_LOCK(m_ControlClientWakeupLock);
+    if(m_ControlClientWakeup)
+      m_ControlClientWakeup->Signal();
+  }
+}
+
+int32_t RenderDoc::ConsumeTargetControlNotifications()
+{
+  // reset before fetching the flags, so that any notification arriving after this point will
+  // signal again.
+  if(m_ControlClientWakeup)
+    m_ControlClientWakeup->Reset();
+
+  int32_t prev;
+  do
+  {
+    prev = m_TargetControlNotify;
+  } while(Atomic::CmpExch32(&m_TargetControlNotify, prev, 0) != prev);
+
+  return prev;
+}
+
 std::map<RDCDriver, std::string> RenderDoc::GetReplayDrivers()
 {
   std::map<RDCDriver, std::string> ret;
@@ -1556,6 +1634,8 @@ void RenderDoc::FinishCaptureWriting(RDCFile *rdc, uint32_t frameNumber)
       m_Captures.push_back(cap);
     }
 
+    NotifyTargetControl(eNotify_Captures);
+
     delete rdc;
   }
   else
@@ -1609,6 +1689,7 @@ void RenderDoc::AddFrameCapturer(void *dev, void *wnd, IFrameCapturer *cap)
   else
   {
     m_WindowFrameCapturers[dw].FrameCapturer = cap;
+    NotifyTargetControl(eNotify_Windows);
   }
 
   // the first one we see becomes the default
@@ -1645,6 +1726,7 @@ void RenderDoc::RemoveFrameCapturer(void *dev, void *wnd)
       }
 
       m_WindowFrameCapturers.erase(it);
+      NotifyTargetControl(eNotify_Windows);
     }
   }
   else
@@ -246,6 +246,16 @@ struct CaptureData
   bool retrieved;
 };
 
+struct RetroactiveCaptureStats
+{
+  // how many frames are currently held in memory
+  uint32_t frames = 0;
+  // the memory used by those frames' commands and the initial state snapshot they start from
+  uint64_t memoryBytes = 0;
+  // how long the application was stalled taking the most recent snapshot
+  double snapshotMS = 0.0;
+};
+
 enum class LoadProgress
 {
   DebugManagerInit,
@@ -456,8 +466,11 @@ public:
 
   void AddChildProcess(uint32_t pid, uint32_t ident)
   {
-    SCOPED_LOCK(m_ChildLock);
-    m_Children.push_back(make_rdcpair(pid, ident));
+    {
+      SCOPED_LOCK(m_ChildLock);
+      m_Children.push_back(make_rdcpair(pid, ident));
+    }
+    NotifyTargetControl(eNotify_Children);
   }
   std::vector<rdcpair<uint32_t, uint32_t> > GetChildProcesses()
   {
@@ -573,6 +586,29 @@ public:
   }
 
   void TriggerCapture(uint32_t numFrames) { m_Cap = numFrames; }
+
+  // retroactive capture keeps the most recent frames in memory on drivers that support it, so
+  // they can be written out after something interesting has happened. 0 frames disables it.
+  void SetRetroactiveFrames(uint32_t numFrames) { m_RetroactiveFrames = numFrames; }
+  uint32_t GetRetroactiveFrames() const { return m_RetroactiveFrames; }
+  void SetRetroactiveMemoryBudget(uint32_t megabytes) { m_RetroactiveBudgetMB = megabytes; }
+  uint32_t GetRetroactiveMemoryBudget() const { return m_RetroactiveBudgetMB; }
+  void TriggerRetroactiveCapture() { Atomic::CmpExch32(&m_RetroactiveRequested, 0, 1); }
+  // returns true once per call to TriggerRetroactiveCapture
+  bool ShouldWriteRetroactiveCapture()
+  {
+    return Atomic::CmpExch32(&m_RetroactiveRequested, 1, 0) == 1;
+  }
+  void SetRetroactiveStats(const RetroactiveCaptureStats &stats)
+  {
+    SCOPED_LOCK(m_RetroactiveLock);
+    m_RetroactiveStats = stats;
+  }
+  RetroactiveCaptureStats GetRetroactiveStats()
+  {
+    SCOPED_LOCK(m_RetroactiveLock);
+    return m_RetroactiveStats;
+  }
   uint32_t GetOverlayBits() { return m_Overlay; }
   void MaskOverlayBits(uint32_t And, uint32_t Or) { m_Overlay = (m_Overlay & And) | Or; }
   void QueueCapture(uint32_t frameNumber) { m_QueuedFrameCaptures.insert(frameNumber); }
@@ -634,8 +670,15 @@ private:
 
   std::set<uint32_t> m_QueuedFrameCaptures;
 
+  uint32_t m_RetroactiveFrames = 0;
+  uint32_t m_RetroactiveBudgetMB = 256;
+  volatile int32_t m_RetroactiveRequested = 0;
+  Threading::CriticalSection m_RetroactiveLock;
+  RetroactiveCaptureStats m_RetroactiveStats;
+
   uint32_t m_RemoteIdent;
   Threading::ThreadHandle m_RemoteThread;
+  Threading::ThreadHandle m_ControlClientThread = 0;
 
   int32_t m_MarkerIndentLevel;
   Threading::CriticalSection m_DriverLock;
@@ -720,6 +763,31 @@ private:
 
   volatile bool m_TargetControlThreadShutdown;
   volatile bool m_ControlClientThreadShutdown;
+  // set on an explicit Shutdown(), which joins the client thread itself. Otherwise we're unloading
+  // and the server thread only closes the client thread's handle on exit.
+  volatile bool m_TargetControlJoinClient = false;
+
+  // state changes that the target control client thread needs to forward. These are published
+  // by setting bits here and signalling the wakeup, so the thread can block on its socket and
+  // only look at state when something has actually changed.
+  enum
+  {
+    eNotify_Drivers = 0x1,
+    eNotify_Captures = 0x2,
+    eNotify_Children = 0x4,
+    eNotify_Progress = 0x8,
+    eNotify_Windows = 0x10,
+    eNotify_All = 0x1f,
+  };
+
+  volatile int32_t m_TargetControlNotify = 0;
+  Network::Wakeup *m_TargetControlWakeup = NULL;
+  Network::Wakeup *m_ControlClientWakeup = NULL;
+  // protects m_ControlClientWakeup being signalled from any thread while it's freed
+  Threading::CriticalSection m_ControlClientWakeupLock;
+
+  void NotifyTargetControl(int32_t flags);
+  int32_t ConsumeTargetControlNotifications();
   Threading::CriticalSection m_SingleClientLock;
   std::string m_SingleClientName;
 
@@ -197,6 +197,7 @@ public:
     return ret;
   }
   rdcarray<GPUDevice> GetAvailableGPUs() { return {}; }
+  InitialStateRestoreStats GetInitialStateRestoreStats() { return InitialStateRestoreStats(); }
   const D3D12Pipe::State *GetD3D12PipelineState() { return NULL; }
   const GLPipe::State *GetGLPipelineState() { return NULL; }
   const VKPipe::State *GetVulkanPipelineState() { return NULL; }
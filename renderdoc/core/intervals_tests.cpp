@@ -28,6 +28,7 @@
 #if ENABLED(ENABLE_UNIT_TESTS)
 
 #include "3rdparty/catch/catch.hpp"
+#include "common/benchmark.h"
 
 #include <stdint.h>
 #include <vector>
@@ -440,4 +441,48 @@ TEST_CASE("Test Intervals type", "[intervals]")
   };
 };
 
+TEST_CASE("Benchmark Intervals", "[intervals][!benchmark]")
+{
+  // like memory reference tracking - many small overlapping writes to a large allocation
+  const int numUpdates = 10000;
+
+  std::vector<std::pair<uint64_t, uint64_t>> ranges;
+  uint32_t state = 12345;
+  for(int i = 0; i < numUpdates; i++)
+  {
+    state = state * 1664525U + 1013904223U;
+    uint64_t start = (state >> 6) & ~0xffULL;
+    state = state * 1664525U + 1013904223U;
+    uint64_t size = 256 + ((state >> 16) & 0xff00);
+    ranges.push_back({start, start + size});
+  }
+
+  auto compose = [](uint64_t x, uint64_t y) -> uint64_t { return x > y ? x : y; };
+
+  Intervals<uint64_t> filled;
+  for(size_t i = 0; i < ranges.size(); i++)
+    filled.update(ranges[i].first, ranges[i].second, i, compose);
+
+  RunBenchmark("Intervals 10000 overlapping updates", 0, [&]() {
+    Intervals<uint64_t> test;
+    for(size_t i = 0; i < ranges.size(); i++)
+      test.update(ranges[i].first, ranges[i].second, i, compose);
+    BenchmarkKeep(test.begin()->value());
+  });
+
+  RunBenchmark("Intervals 10000 lookups", 0, [&]() {
+    uint64_t sum = 0;
+    for(size_t i = 0; i < ranges.size(); i++)
+      sum += filled.find(ranges[i].first)->value();
+    BenchmarkKeep(sum);
+  });
+
+  RunBenchmark("Intervals merge", 0, [&]() {
+    Intervals<uint64_t> test;
+    test.update(0, 1ULL << 32, 1, compose);
+    test.merge(filled, compose);
+    BenchmarkKeep(test.begin()->value());
+  });
+}
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
\ No newline at end of file
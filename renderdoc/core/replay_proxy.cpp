@@ -92,6 +92,8 @@ rdcstr DoStringise(const ReplayProxyPacket &el)
     STRINGISE_ENUM_NAMED(eReplayProxy_GetTargetShaderEncodings, "GetTargetShaderEncodings");
 
     STRINGISE_ENUM_NAMED(eReplayProxy_GetDriverInfo, "GetDriverInfo");
+
+    STRINGISE_ENUM_NAMED(eReplayProxy_GetInitialStateRestoreStats, "GetInitialStateRestoreStats");
   }
   END_ENUM_STRINGISE();
 }
@@ -353,6 +355,35 @@ rdcarray<GPUDevice> ReplayProxy::GetAvailableGPUs()
   PROXY_FUNCTION(GetAvailableGPUs);
 }
 
+template <typename ParamSerialiser, typename ReturnSerialiser>
+InitialStateRestoreStats ReplayProxy::Proxied_GetInitialStateRestoreStats(ParamSerialiser &paramser,
+                                                                          ReturnSerialiser &retser)
+{
+  const ReplayProxyPacket expectedPacket = eReplayProxy_GetInitialStateRestoreStats;
+  ReplayProxyPacket packet = eReplayProxy_GetInitialStateRestoreStats;
+  InitialStateRestoreStats ret;
+
+  {
+    BEGIN_PARAMS();
+    END_PARAMS();
+  }
+
+  {
+    REMOTE_EXECUTION();
+    if(paramser.IsReading() && !paramser.IsErrored() && !m_IsErrored)
+      ret = m_Remote->GetInitialStateRestoreStats();
+  }
+
+  SERIALISE_RETURN(ret);
+
+  return ret;
+}
+
+InitialStateRestoreStats ReplayProxy::GetInitialStateRestoreStats()
+{
+  PROXY_FUNCTION(GetInitialStateRestoreStats);
+}
+
 template <typename ParamSerialiser, typename ReturnSerialiser>
 std::vector<DebugMessage> ReplayProxy::Proxied_GetDebugMessages(ParamSerialiser &paramser,
                                                                 ReturnSerialiser &retser)
@@ -2697,6 +2728,7 @@ bool ReplayProxy::Tick(int type)
     case eReplayProxy_GetTargetShaderEncodings: GetTargetShaderEncodings(); break;
     case eReplayProxy_GetDriverInfo: GetDriverInfo(); break;
     case eReplayProxy_GetAvailableGPUs: GetAvailableGPUs(); break;
+    case eReplayProxy_GetInitialStateRestoreStats: GetInitialStateRestoreStats(); break;
     default: RDCERR("Unexpected command %u", type); return false;
   }
 
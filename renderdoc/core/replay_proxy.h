@@ -100,6 +100,8 @@ enum ReplayProxyPacket
 
   eReplayProxy_GetDriverInfo,
   eReplayProxy_GetAvailableGPUs,
+
+  eReplayProxy_GetInitialStateRestoreStats,
 };
 
 DECLARE_REFLECTION_ENUM(ReplayProxyPacket);
@@ -472,6 +474,7 @@ public:
   IMPLEMENT_FUNCTION_PROXIED(APIProperties, GetAPIProperties);
   IMPLEMENT_FUNCTION_PROXIED(DriverInformation, GetDriverInfo);
   IMPLEMENT_FUNCTION_PROXIED(rdcarray<GPUDevice>, GetAvailableGPUs);
+  IMPLEMENT_FUNCTION_PROXIED(InitialStateRestoreStats, GetInitialStateRestoreStats);
 
   IMPLEMENT_FUNCTION_PROXIED(std::vector<DebugMessage>, GetDebugMessages);
 
@@ -29,7 +29,9 @@
 #include <set>
 #include "api/replay/renderdoc_replay.h"
 #include "common/threading.h"
+#include "common/timing.h"
 #include "core/core.h"
+#include "core/sharded_map.h"
 #include "os/os_specific.h"
 #include "serialise/serialiser.h"
 
@@ -400,6 +402,15 @@ struct ResourceRecord
 
   bool HasChunks() const { return !m_Chunks.empty(); }
   size_t NumChunks() const { return m_Chunks.size(); }
+  uint64_t ChunksSize()
+  {
+    uint64_t ret = 0;
+    LockChunks();
+    for(auto it = m_Chunks.begin(); it != m_Chunks.end(); ++it)
+      ret += it->second->GetLength();
+    UnlockChunks();
+    return ret;
+  }
   void SwapChunks(ResourceRecord *other)
   {
     LockChunks();
@@ -623,6 +634,13 @@ public:
   // Apply the initial contents for the resources that need them, used at the start of a frame
   void ApplyInitialContents();
 
+  // after a resource's initial contents have been applied, if the driver tracks writes to it then
+  // it's considered clean and won't be applied again until it's marked dirty by the replay.
+  void MarkInitialContentsDirty(ResourceId origid);
+  void MarkAllInitialContentsDirty();
+
+  const InitialStateRestoreStats &GetInitialStateRestoreStats() { return m_RestoreStats; }
+
   // Resource wrapping, allows for querying and adding/removing of wrapper layers around resources
   bool AddWrapper(WrappedResourceType wrap, RealResourceType real);
   bool HasWrapper(RealResourceType real);
@@ -653,35 +671,46 @@ protected:
     return true;
   }
   virtual bool Prepare_InitialState(WrappedResourceType res) = 0;
+  // called around the bulk preparation at the start of a capture. Between these the driver doesn't
+  // have to wait for each resource's copy to complete, as long as everything is finished by the
+  // time End_PrepareInitialBatch returns.
+  virtual void Begin_PrepareInitialBatch() {}
+  virtual void End_PrepareInitialBatch() {}
+  // used to group timings of initial state preparation
+  virtual std::string GetInitialStateTypeName(WrappedResourceType res) { return "Resource"; }
   virtual uint64_t GetSize_InitialState(ResourceId id, const InitialContentData &initial) = 0;
   virtual bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, RecordType *record,
                                       const InitialContentData *initialData) = 0;
   virtual void Create_InitialState(ResourceId id, WrappedResourceType live, bool hasData) = 0;
   virtual void Apply_InitialState(WrappedResourceType live, const InitialContentData &initial) = 0;
   virtual std::vector<ResourceId> InitialContentResources();
+  // return true if every replayed write to this resource is reported through
+  // MarkInitialContentsDirty, so applying its initial contents can be skipped while it's clean.
+  virtual bool IsInitialStateWriteTracked(ResourceId id, const InitialContentData &initial)
+  {
+    return false;
+  }
+  // the number of bytes copied when applying this initial state, for statistics only
+  virtual uint64_t GetRestoreSize_InitialState(ResourceId id, const InitialContentData &initial)
+  {
+    return 0;
+  }
 
-  // very coarse lock, protects EVERYTHING. This could certainly be improved and it may be a
-  // bottleneck
-  // for performance. Given that the main use cases are write-rarely read-often the lock should be
-  // optimised
-  // for that as we only want to make sure we're not modifying the objects together, by far the most
-  // common
-  // operation is looking up data.
+  // coarse lock protecting the plain std::map members below. The maps that are hit on every API
+  // call during capture (records, current resources, frame references, dirty and write-time
+  // tracking) are ShardedResourceMaps with their own locking and don't need this at all.
   Threading::CriticalSection m_Lock;
 
-  // easy optimisation win - don't use maps everywhere. It's convenient but not optimal, and
-  // profiling will
-  // likely prove that some or all of these could be a problem
-
   // used during capture - map from real resource to its wrapper (other way can be done just with an
   // Unwrap)
   std::map<RealResourceType, WrappedResourceType> m_WrapperMap;
 
   // used during capture - holds resources referenced in current frame (and how they're referenced)
-  std::map<ResourceId, FrameRefType> m_FrameReferencedResources;
+  ShardedResourceMap<FrameRefType> m_FrameReferencedResources;
 
-  // used during capture - holds resources marked as dirty, needing initial contents
-  std::set<ResourceId> m_DirtyResources;
+  // used during capture - holds resources marked as dirty, needing initial contents. Only the
+  // presence of a key matters, the value is unused.
+  ShardedResourceMap<bool> m_DirtyResources;
 
   struct InitialContentDataOrChunk
   {
@@ -703,9 +732,14 @@ protected:
   // used during capture or replay - holds initial contents
   std::map<ResourceId, InitialContentDataOrChunk> m_InitialContents;
 
+  // used during replay - original IDs of write-tracked resources whose initial contents have been
+  // applied and not modified since.
+  std::set<ResourceId> m_CleanInitialContents;
+  InitialStateRestoreStats m_RestoreStats;
+
   // used during capture or replay - map of resources currently alive with their real IDs, used in
   // capture and replay.
-  std::map<ResourceId, WrappedResourceType> m_CurrentResourceMap;
+  ShardedResourceMap<WrappedResourceType> m_CurrentResourceMap;
 
   // used during replay - maps back and forth from original id to live id and vice-versa
   std::map<ResourceId, ResourceId> m_OriginalIDs, m_LiveIDs;
@@ -714,19 +748,23 @@ protected:
   std::map<ResourceId, WrappedResourceType> m_LiveResourceMap;
 
   // used during capture - holds resource records by id.
-  std::map<ResourceId, RecordType *> m_ResourceRecords;
+  ShardedResourceMap<RecordType *> m_ResourceRecords;
 
   // used during replay - holds current resource replacements
   std::map<ResourceId, ResourceId> m_Replacements;
 
+  // set under m_Lock whenever m_Replacements is non-empty, so GetCurrentResource can skip the lock
+  // on capture where there are never any replacements.
+  volatile int32_t m_HasReplacements = 0;
+
   // During initial resources preparation, persistent resources are
-  // postponed until serializing to RDC file.
-  std::set<ResourceId> m_PostponedResourceIDs;
+  // postponed until serializing to RDC file. Only the presence of a key matters.
+  ShardedResourceMap<bool> m_PostponedResourceIDs;
 
   // On marking resource write-referenced in frame, its last write
   // time is reset. The time is used to determine persistent resources,
   // and is checked against the `PERSISTENT_RESOURCE_AGE`.
-  std::map<ResourceId, double> m_LastWriteTime;
+  ShardedResourceMap<double> m_LastWriteTime;
 
   // Timestamp at the beginning of the frame capture. Used to determine which
   // resources to refresh for their last write time (see `m_LastWriteTime`).
@@ -761,7 +799,7 @@ void ResourceManager<Configuration>::Shutdown()
       m_LiveResourceMap.erase(removeit);
   }
 
-  RDCASSERT(m_ResourceRecords.empty());
+  RDCASSERT(m_ResourceRecords.IsEmpty());
 }
 
 template <typename Configuration>
@@ -769,7 +807,7 @@ ResourceManager<Configuration>::~ResourceManager()
 {
   RDCASSERT(m_LiveResourceMap.empty());
   RDCASSERT(m_InitialContents.empty());
-  RDCASSERT(m_ResourceRecords.empty());
+  RDCASSERT(m_ResourceRecords.IsEmpty());
 
   if(RenderDoc::Inst().GetCrashHandler())
     RenderDoc::Inst().GetCrashHandler()->UnregisterMemoryRegion(this);
@@ -780,8 +818,6 @@ template <typename Compose>
 void ResourceManager<Configuration>::MarkResourceFrameReferenced(ResourceId id,
                                                                  FrameRefType refType, Compose comp)
 {
-  SCOPED_LOCK(m_Lock);
-
   if(id == ResourceId())
     return;
 
@@ -794,15 +830,29 @@ void ResourceManager<Configuration>::MarkResourceFrameReferenced(ResourceId id,
   if(IsBackgroundCapturing(m_State))
     return;
 
-  bool newRef = MarkReferenced(m_FrameReferencedResources, id, refType, comp);
+  // most references are to a resource that's already been referenced in a way that this one
+  // doesn't change, which can be checked with only a shared lock on its shard.
+  FrameRefType prevRef = eFrameRef_None;
+  if(m_FrameReferencedResources.Find(id, prevRef) && comp(prevRef, refType) == prevRef)
+    return;
 
-  if(newRef)
-  {
-    RecordType *record = GetResourceRecord(id);
+  // the record's ref is added while the shard is still locked, so that ClearReferencedResources
+  // can never take this reference and release it before the matching AddRef.
+  m_FrameReferencedResources.Apply(id, [this, id, refType, comp](FrameRefType &ref, bool isNew) {
+    if(isNew)
+    {
+      ref = refType;
 
-    if(record)
-      record->AddRef();
-  }
+      RecordType *record = GetResourceRecord(id);
+
+      if(record)
+        record->AddRef();
+    }
+    else
+    {
+      ref = comp(ref, refType);
+    }
+  });
 }
 
 template <typename Configuration>
@@ -814,23 +864,19 @@ void ResourceManager<Configuration>::MarkResourceFrameReferenced(ResourceId id,
 template <typename Configuration>
 void ResourceManager<Configuration>::MarkDirtyResource(ResourceId res)
 {
-  SCOPED_LOCK(m_Lock);
-
   if(res == ResourceId())
     return;
 
-  m_DirtyResources.insert(res);
+  m_DirtyResources.Set(res, true);
 }
 
 template <typename Configuration>
 bool ResourceManager<Configuration>::IsResourceDirty(ResourceId res)
 {
-  SCOPED_LOCK(m_Lock);
-
   if(res == ResourceId())
     return false;
 
-  return m_DirtyResources.find(res) != m_DirtyResources.end();
+  return m_DirtyResources.Contains(res);
 }
 
 template <typename Configuration>
@@ -846,6 +892,7 @@ void ResourceManager<Configuration>::SetInitialContents(ResourceId id, InitialCo
     it->second.Free(this);
 
   m_InitialContents[id].data = contents;
+  m_CleanInitialContents.erase(id);
 }
 
 template <typename Configuration>
@@ -907,12 +954,15 @@ void ResourceManager<Configuration>::Serialise_InitialContentsNeeded(WriteSerial
 
   std::vector<WrittenRecord> WrittenRecords;
 
+  std::vector<typename ShardedResourceMap<FrameRefType>::Entry> frameRefs;
+  m_FrameReferencedResources.GetAll(frameRefs);
+
   // reasonable estimate, and these records are small
-  WrittenRecords.reserve(m_FrameReferencedResources.size());
+  WrittenRecords.reserve(frameRefs.size());
 
   // all resources that were recorded as being modified should be included in the list of those
   // needing initial contents
-  for(auto it = m_FrameReferencedResources.begin(); it != m_FrameReferencedResources.end(); ++it)
+  for(auto it = frameRefs.begin(); it != frameRefs.end(); ++it)
   {
     RecordType *record = GetResourceRecord(it->first);
     if(IsDirtyFrameRef(it->second))
@@ -927,8 +977,8 @@ void ResourceManager<Configuration>::Serialise_InitialContentsNeeded(WriteSerial
   for(auto it = m_InitialContents.begin(); it != m_InitialContents.end(); ++it)
   {
     ResourceId id = it->first;
-    auto ref = m_FrameReferencedResources.find(id);
-    if(ref == m_FrameReferencedResources.end() || !IsDirtyFrameRef(ref->second))
+    FrameRefType ref = eFrameRef_None;
+    if(!m_FrameReferencedResources.Find(id, ref) || !IsDirtyFrameRef(ref))
     {
       WrittenRecord wr = {id, true};
 
@@ -952,7 +1002,8 @@ void ResourceManager<Configuration>::FreeInitialContents()
     if(!m_InitialContents.empty())
       m_InitialContents.erase(m_InitialContents.begin());
   }
-  m_PostponedResourceIDs.clear();
+  m_CleanInitialContents.clear();
+  m_PostponedResourceIDs.Clear();
 }
 
 template <typename Configuration>
@@ -966,16 +1017,15 @@ void ResourceManager<Configuration>::Prepare_ResourceInitialStateIfNeeded(Resour
   WrappedResourceType res = GetCurrentResource(id);
   Prepare_InitialState(res);
 
-  m_PostponedResourceIDs.erase(id);
+  m_PostponedResourceIDs.Erase(id);
 }
 
 template <typename Configuration>
 void ResourceManager<Configuration>::Prepare_ResourceIfActivePostponed(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
   // If the resource was postponed during Active Capture, we need to prepare it
-  // right away, since next Read might be invalid.
+  // right away, since next Read might be invalid. This is checked without m_Lock since it's called
+  // on every write reference, Prepare_ResourceInitialStateIfNeeded locks and checks again.
   if(!IsActiveCapturing(m_State) || !IsResourcePostponed(id))
     return;
 
@@ -986,8 +1036,7 @@ void ResourceManager<Configuration>::Prepare_ResourceIfActivePostponed(ResourceI
 template <typename Configuration>
 inline void ResourceManager<Configuration>::UpdateLastWriteTime(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-  m_LastWriteTime[id] = m_ResourcesUpdateTimer.GetMilliseconds();
+  m_LastWriteTime.Set(id, m_ResourcesUpdateTimer.GetMilliseconds());
 }
 
 template <typename Configuration>
@@ -1003,40 +1052,36 @@ template <typename Configuration>
 inline void ResourceManager<Configuration>::ResetLastWriteTimes()
 {
   SCOPED_LOCK(m_Lock);
-  for(auto it = m_LastWriteTime.begin(); it != m_LastWriteTime.end(); ++it)
-  {
+  double captureStart = m_captureStartTime;
+  double now = m_ResourcesUpdateTimer.GetMilliseconds();
+  m_LastWriteTime.ApplyAll([captureStart, now](ResourceId, double &lastWrite) {
     // Reset only those resources which were below the threshold on
     // capture start. Other resource are already above the threshold.
-    if(m_captureStartTime - it->second <= PERSISTENT_RESOURCE_AGE)
-      it->second = m_ResourcesUpdateTimer.GetMilliseconds();
-  }
+    if(captureStart - lastWrite <= PERSISTENT_RESOURCE_AGE)
+      lastWrite = now;
+  });
 }
 
 template <typename Configuration>
 inline bool ResourceManager<Configuration>::HasPersistentAge(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  auto it = m_LastWriteTime.find(id);
+  double lastWrite = 0.0;
 
-  if(it == m_LastWriteTime.end())
+  if(!m_LastWriteTime.Find(id, lastWrite))
     return true;
 
-  return m_ResourcesUpdateTimer.GetMilliseconds() - it->second >= PERSISTENT_RESOURCE_AGE;
+  return m_ResourcesUpdateTimer.GetMilliseconds() - lastWrite >= PERSISTENT_RESOURCE_AGE;
 }
 
 template <typename Configuration>
 inline bool ResourceManager<Configuration>::IsResourcePostponed(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-  return m_PostponedResourceIDs.find(id) != m_PostponedResourceIDs.end();
+  return m_PostponedResourceIDs.Contains(id);
 }
 
 template <typename Configuration>
 inline bool ResourceManager<Configuration>::IsResourcePersistent(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
   WrappedResourceType res = GetCurrentResource(id);
 
   if(!IsResourceTrackedForPersistency(res))
@@ -1065,6 +1110,9 @@ void ResourceManager<Configuration>::CreateInitialContents(ReadSerialiser &ser)
       Create_InitialState(id, GetLiveResource(id), wr.written);
   }
 
+  // the resources may have been modified while loading, so everything must be applied once
+  MarkAllInitialContentsDirty();
+
   for(auto it = m_InitialContents.begin(); it != m_InitialContents.end();)
   {
     ResourceId id = it->first;
@@ -1087,14 +1135,56 @@ void ResourceManager<Configuration>::ApplyInitialContents()
 {
   RDCDEBUG("Applying initial contents");
   std::vector<ResourceId> resources = InitialContentResources();
+
+  uint32_t numApplied = 0, numSkipped = 0;
+  uint64_t appliedBytes = 0, skippedBytes = 0;
+
   for(auto it = resources.begin(); it != resources.end(); ++it)
   {
     ResourceId id = *it;
     const InitialContentDataOrChunk &data = m_InitialContents[id];
+    uint64_t size = GetRestoreSize_InitialState(id, data.data);
+
+    // nothing has written to this resource since its contents were last applied
+    if(m_CleanInitialContents.find(id) != m_CleanInitialContents.end())
+    {
+      numSkipped++;
+      skippedBytes += size;
+      continue;
+    }
+
     WrappedResourceType live = GetLiveResource(id);
     Apply_InitialState(live, data.data);
+
+    numApplied++;
+    appliedBytes += size;
+
+    if(IsInitialStateWriteTracked(id, data.data))
+      m_CleanInitialContents.insert(id);
   }
-  RDCDEBUG("Applied %d", (uint32_t)resources.size());
+
+  m_RestoreStats.numRestores++;
+  m_RestoreStats.lastRestoredResources = numApplied;
+  m_RestoreStats.lastSkippedResources = numSkipped;
+  m_RestoreStats.lastRestoredBytes = appliedBytes;
+  m_RestoreStats.lastSkippedBytes = skippedBytes;
+  m_RestoreStats.totalRestoredBytes += appliedBytes;
+  m_RestoreStats.totalSkippedBytes += skippedBytes;
+
+  RDCDEBUG("Applied %u (%llu bytes), skipped %u unmodified (%llu bytes)", numApplied, appliedBytes,
+           numSkipped, skippedBytes);
+}
+
+template <typename Configuration>
+void ResourceManager<Configuration>::MarkInitialContentsDirty(ResourceId origid)
+{
+  m_CleanInitialContents.erase(origid);
+}
+
+template <typename Configuration>
+void ResourceManager<Configuration>::MarkAllInitialContentsDirty()
+{
+  m_CleanInitialContents.clear();
 }
 
 template <typename Configuration>
@@ -1116,12 +1206,7 @@ std::vector<ResourceId> ResourceManager<Configuration>::InitialContentResources(
 template <typename Configuration>
 void ResourceManager<Configuration>::MarkUnwrittenResources()
 {
-  SCOPED_LOCK(m_Lock);
-
-  for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
-  {
-    it->second->MarkDataUnwritten();
-  }
+  m_ResourceRecords.ApplyAll([](ResourceId, RecordType *record) { record->MarkDataUnwritten(); });
 }
 
 template <typename Configuration>
@@ -1131,20 +1216,25 @@ void ResourceManager<Configuration>::InsertReferencedChunks(WriteSerialiser &ser
 
   SCOPED_LOCK(m_Lock);
 
-  RDCDEBUG("%u frame resource records", (uint32_t)m_FrameReferencedResources.size());
+  std::vector<typename ShardedResourceMap<FrameRefType>::Entry> frameRefs;
+  m_FrameReferencedResources.GetAll(frameRefs);
+
+  RDCDEBUG("%u frame resource records", (uint32_t)frameRefs.size());
 
   if(RenderDoc::Inst().GetCaptureOptions().refAllResources)
   {
-    float num = float(m_ResourceRecords.size());
+    std::vector<typename ShardedResourceMap<RecordType *>::Entry> records;
+    m_ResourceRecords.GetAll(records);
+
+    float num = float(records.size());
     float idx = 0.0f;
 
-    for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
+    for(auto it = records.begin(); it != records.end(); ++it)
     {
       RenderDoc::Inst().SetProgress(CaptureProgress::AddReferencedResources, idx / num);
       idx += 1.0f;
 
-      if(m_FrameReferencedResources.find(it->first) == m_FrameReferencedResources.end() &&
-         it->second->InternalResource)
+      if(!m_FrameReferencedResources.Contains(it->first) && it->second->InternalResource)
         continue;
 
       it->second->Insert(sortedChunks);
@@ -1152,10 +1242,10 @@ void ResourceManager<Configuration>::InsertReferencedChunks(WriteSerialiser &ser
   }
   else
   {
-    float num = float(m_FrameReferencedResources.size());
+    float num = float(frameRefs.size());
     float idx = 0.0f;
 
-    for(auto it = m_FrameReferencedResources.begin(); it != m_FrameReferencedResources.end(); ++it)
+    for(auto it = frameRefs.begin(); it != frameRefs.end(); ++it)
     {
       RenderDoc::Inst().SetProgress(CaptureProgress::AddReferencedResources, idx / num);
       idx += 1.0f;
@@ -1179,15 +1269,30 @@ void ResourceManager<Configuration>::PrepareInitialContents()
 {
   SCOPED_LOCK(m_Lock);
 
-  RDCDEBUG("Preparing up to %u potentially dirty resources", (uint32_t)m_DirtyResources.size());
+  std::vector<typename ShardedResourceMap<bool>::Entry> dirtyResources;
+  m_DirtyResources.GetAll(dirtyResources);
+
+  RDCDEBUG("Preparing up to %u potentially dirty resources", (uint32_t)dirtyResources.size());
   uint32_t prepared = 0;
 
-  float num = float(m_DirtyResources.size());
+  float num = float(dirtyResources.size());
   float idx = 0.0f;
 
-  for(auto it = m_DirtyResources.begin(); it != m_DirtyResources.end(); ++it)
+  struct TypeTiming
   {
-    ResourceId id = *it;
+    uint32_t count = 0;
+    double milliseconds = 0.0;
+  };
+
+  std::map<std::string, TypeTiming> timings;
+
+  PerformanceTimer totalTimer;
+
+  Begin_PrepareInitialBatch();
+
+  for(auto it = dirtyResources.begin(); it != dirtyResources.end(); ++it)
+  {
+    ResourceId id = it->first;
 
     RenderDoc::Inst().SetProgress(CaptureProgress::PrepareInitialStates, idx / num);
     idx += 1.0f;
@@ -1207,7 +1312,7 @@ void ResourceManager<Configuration>::PrepareInitialContents()
 
     if(IsResourcePersistent(id))
     {
-      m_PostponedResourceIDs.insert(id);
+      m_PostponedResourceIDs.Set(id, true);
       // Set empty contents here, it'll be prepared on serialization.
       SetInitialContents(id, InitialContentData());
       continue;
@@ -1219,10 +1324,29 @@ void ResourceManager<Configuration>::PrepareInitialContents()
     RDCDEBUG("Prepare Resource %llu", id);
 #endif
 
+    PerformanceTimer timer;
+
     Prepare_InitialState(res);
+
+    TypeTiming &timing = timings[GetInitialStateTypeName(res)];
+    timing.count++;
+    timing.milliseconds += timer.GetMilliseconds();
   }
 
+  // any batched work still outstanding is waited on here, so count it separately
+  PerformanceTimer flushTimer;
+
+  End_PrepareInitialBatch();
+
+  double flushMilliseconds = flushTimer.GetMilliseconds();
+
   RDCDEBUG("Prepared %u dirty resources", prepared);
+
+  RDCLOG("Initial state preparation took %.2f ms (%.2f ms waiting on final batch)",
+         totalTimer.GetMilliseconds(), flushMilliseconds);
+
+  for(auto it = timings.begin(); it != timings.end(); ++it)
+    RDCLOG("  %u %s: %.2f ms", it->second.count, it->first.c_str(), it->second.milliseconds);
 }
 
 template <typename Configuration>
@@ -1245,7 +1369,7 @@ void ResourceManager<Configuration>::InsertInitialContentsChunks(WriteSerialiser
     RenderDoc::Inst().SetProgress(CaptureProgress::SerialiseInitialStates, idx / num);
     idx += 1.0f;
 
-    if(m_FrameReferencedResources.find(id) == m_FrameReferencedResources.end() &&
+    if(!m_FrameReferencedResources.Contains(id) &&
        !RenderDoc::Inst().GetCaptureOptions().refAllResources)
     {
 #if ENABLED(VERBOSE_DIRTY_RESOURCES)
@@ -1318,7 +1442,7 @@ void ResourceManager<Configuration>::ApplyInitialContentsNonChunks(WriteSerialis
   {
     ResourceId id = it->first;
 
-    if(m_FrameReferencedResources.find(id) == m_FrameReferencedResources.end() &&
+    if(!m_FrameReferencedResources.Contains(id) &&
        !RenderDoc::Inst().GetCaptureOptions().refAllResources)
     {
       continue;
@@ -1339,7 +1463,10 @@ void ResourceManager<Configuration>::ClearReferencedResources()
 {
   SCOPED_LOCK(m_Lock);
 
-  for(auto it = m_FrameReferencedResources.begin(); it != m_FrameReferencedResources.end(); ++it)
+  std::vector<typename ShardedResourceMap<FrameRefType>::Entry> frameRefs;
+  m_FrameReferencedResources.TakeAll(frameRefs);
+
+  for(auto it = frameRefs.begin(); it != frameRefs.end(); ++it)
   {
     RecordType *record = GetResourceRecord(it->first);
 
@@ -1350,8 +1477,6 @@ void ResourceManager<Configuration>::ClearReferencedResources()
       record->Delete(this);
     }
   }
-
-  m_FrameReferencedResources.clear();
 }
 
 template <typename Configuration>
@@ -1360,7 +1485,10 @@ void ResourceManager<Configuration>::ReplaceResource(ResourceId from, ResourceId
   SCOPED_LOCK(m_Lock);
 
   if(HasLiveResource(to))
+  {
     m_Replacements[from] = to;
+    Atomic::CmpExch32(&m_HasReplacements, 0, 1);
+  }
 }
 
 template <typename Configuration>
@@ -1382,52 +1510,41 @@ void ResourceManager<Configuration>::RemoveReplacement(ResourceId id)
     return;
 
   m_Replacements.erase(it);
+
+  if(m_Replacements.empty())
+    Atomic::CmpExch32(&m_HasReplacements, 1, 0);
 }
 
 template <typename Configuration>
 typename Configuration::RecordType *ResourceManager<Configuration>::GetResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  auto it = m_ResourceRecords.find(id);
-
-  if(it == m_ResourceRecords.end())
-    return NULL;
-
-  return it->second;
+  RecordType *record = NULL;
+  m_ResourceRecords.Find(id, record);
+  return record;
 }
 
 template <typename Configuration>
 bool ResourceManager<Configuration>::HasResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  auto it = m_ResourceRecords.find(id);
-
-  if(it == m_ResourceRecords.end())
-    return false;
-
-  return true;
+  return m_ResourceRecords.Contains(id);
 }
 
 template <typename Configuration>
 typename Configuration::RecordType *ResourceManager<Configuration>::AddResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
+  RecordType *record = new RecordType(id);
 
-  RDCASSERT(m_ResourceRecords.find(id) == m_ResourceRecords.end(), id);
+  bool isNew = m_ResourceRecords.Set(id, record);
+  RDCASSERT(isNew, id);
 
-  return (m_ResourceRecords[id] = new RecordType(id));
+  return record;
 }
 
 template <typename Configuration>
 void ResourceManager<Configuration>::RemoveResourceRecord(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  RDCASSERT(m_ResourceRecords.find(id) != m_ResourceRecords.end(), id);
-
-  m_ResourceRecords.erase(id);
+  bool existed = m_ResourceRecords.Erase(id);
+  RDCASSERT(existed, id);
 }
 
 template <typename Configuration>
@@ -1574,50 +1691,51 @@ void ResourceManager<Configuration>::EraseLiveResource(ResourceId origid)
 template <typename Configuration>
 void ResourceManager<Configuration>::AddCurrentResource(ResourceId id, WrappedResourceType res)
 {
-  SCOPED_LOCK(m_Lock);
-
-  RDCASSERT(m_CurrentResourceMap.find(id) == m_CurrentResourceMap.end(), id);
-  m_CurrentResourceMap[id] = res;
+  bool isNew = m_CurrentResourceMap.Set(id, res);
+  RDCASSERT(isNew, id);
 }
 
 template <typename Configuration>
 bool ResourceManager<Configuration>::HasCurrentResource(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  return m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end();
+  return m_CurrentResourceMap.Contains(id);
 }
 
 template <typename Configuration>
 typename Configuration::WrappedResourceType ResourceManager<Configuration>::GetCurrentResource(
     ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
   if(id == ResourceId())
     return (WrappedResourceType)RecordType::NullResource;
 
-  if(m_Replacements.find(id) != m_Replacements.end())
-    return GetCurrentResource(m_Replacements[id]);
+  // replacements are only ever made on replay, so during capture the lock can be skipped.
+  if(Atomic::CmpExch32(&m_HasReplacements, 0, 0) != 0)
+  {
+    SCOPED_LOCK(m_Lock);
+
+    auto it = m_Replacements.find(id);
+    if(it != m_Replacements.end())
+      return GetCurrentResource(it->second);
+  }
 
-  RDCASSERT(m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end(), id);
-  return m_CurrentResourceMap[id];
+  WrappedResourceType ret = (WrappedResourceType)RecordType::NullResource;
+  bool found = m_CurrentResourceMap.Find(id, ret);
+  RDCASSERT(found, id);
+  return ret;
 }
 
 template <typename Configuration>
 void ResourceManager<Configuration>::ReleaseCurrentResource(ResourceId id)
 {
-  SCOPED_LOCK(m_Lock);
-
-  RDCASSERT(m_CurrentResourceMap.find(id) != m_CurrentResourceMap.end(), id);
+  RDCASSERT(m_CurrentResourceMap.Contains(id), id);
 
   // We potentially need to prepare this resource on Active Capture,
   // if it was postponed, but is about to go away.
   Prepare_ResourceIfActivePostponed(id);
 
-  m_CurrentResourceMap.erase(id);
-  m_DirtyResources.erase(id);
-  m_LastWriteTime.erase(id);
+  m_CurrentResourceMap.Erase(id);
+  m_DirtyResources.Erase(id);
+  m_LastWriteTime.Erase(id);
 }
 
 template <typename Configuration>
@@ -0,0 +1,215 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <string.h>
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "api/replay/renderdoc_replay.h"
+#include "common/threading.h"
+
+// A map keyed by ResourceId that is split into a fixed number of shards, each with its own
+// read/write lock. Resource IDs are handed out sequentially so the low bits spread resources
+// evenly across shards, and threads working on different resources almost never touch the same
+// lock. Lookups only take a shared lock on one shard so they never wait on each other.
+//
+// There are no iterators since they can't be held safely while other threads modify the map.
+// Bulk operations either copy out a sorted snapshot, or run a callback on every value with each
+// shard's lock held in turn. Those callbacks must not call back into anything that could lock the
+// same map.
+template <typename Value, uint32_t ShardCount = 16>
+class ShardedResourceMap
+{
+public:
+  typedef std::pair<ResourceId, Value> Entry;
+
+  ShardedResourceMap() = default;
+  ShardedResourceMap(const ShardedResourceMap &) = delete;
+  ShardedResourceMap &operator=(const ShardedResourceMap &) = delete;
+
+  bool Contains(ResourceId id) const
+  {
+    const Shard &s = GetShard(id);
+    SCOPED_READLOCK(s.lock);
+    return s.map.find(id) != s.map.end();
+  }
+
+  // fills out value and returns true if id is present, otherwise leaves value untouched
+  bool Find(ResourceId id, Value &value) const
+  {
+    const Shard &s = GetShard(id);
+    SCOPED_READLOCK(s.lock);
+    auto it = s.map.find(id);
+    if(it == s.map.end())
+      return false;
+    value = it->second;
+    return true;
+  }
+
+  // inserts or overwrites the value for id. Returns true if id was not present before
+  bool Set(ResourceId id, const Value &value)
+  {
+    Shard &s = GetShard(id);
+    SCOPED_WRITELOCK(s.lock);
+    auto it = s.map.find(id);
+    if(it == s.map.end())
+    {
+      s.map.insert(std::make_pair(id, value));
+      return true;
+    }
+    it->second = value;
+    return false;
+  }
+
+  // calls f(Value &value, bool isNew) with the shard locked for writing, default-constructing the
+  // value first if id isn't present. Returns true if the value was newly inserted
+  template <typename Func>
+  bool Apply(ResourceId id, Func f)
+  {
+    Shard &s = GetShard(id);
+    SCOPED_WRITELOCK(s.lock);
+    auto it = s.map.find(id);
+    bool isNew = (it == s.map.end());
+    if(isNew)
+      it = s.map.insert(std::make_pair(id, Value())).first;
+    f(it->second, isNew);
+    return isNew;
+  }
+
+  // returns true if id was present
+  bool Erase(ResourceId id)
+  {
+    Shard &s = GetShard(id);
+    SCOPED_WRITELOCK(s.lock);
+    return s.map.erase(id) > 0;
+  }
+
+  // calls f(ResourceId id, Value &value) for every entry, in no particular order
+  template <typename Func>
+  void ApplyAll(Func f)
+  {
+    for(Shard &s : m_Shards)
+    {
+      SCOPED_WRITELOCK(s.lock);
+      for(auto it = s.map.begin(); it != s.map.end(); ++it)
+        f(it->first, it->second);
+    }
+  }
+
+  // copies every entry out, sorted by ID so that callers iterate in the same order as a std::map
+  void GetAll(std::vector<Entry> &entries) const
+  {
+    entries.clear();
+    entries.reserve(Size());
+    for(const Shard &s : m_Shards)
+    {
+      SCOPED_READLOCK(s.lock);
+      entries.insert(entries.end(), s.map.begin(), s.map.end());
+    }
+    SortEntries(entries);
+  }
+
+  // as GetAll but empties the map at the same time, so that no entry added concurrently can be
+  // lost between reading and clearing.
+  void TakeAll(std::vector<Entry> &entries)
+  {
+    entries.clear();
+    for(Shard &s : m_Shards)
+    {
+      SCOPED_WRITELOCK(s.lock);
+      entries.insert(entries.end(), s.map.begin(), s.map.end());
+      s.map.clear();
+    }
+    SortEntries(entries);
+  }
+
+  size_t Size() const
+  {
+    size_t ret = 0;
+    for(const Shard &s : m_Shards)
+    {
+      SCOPED_READLOCK(s.lock);
+      ret += s.map.size();
+    }
+    return ret;
+  }
+
+  bool IsEmpty() const
+  {
+    for(const Shard &s : m_Shards)
+    {
+      SCOPED_READLOCK(s.lock);
+      if(!s.map.empty())
+        return false;
+    }
+    return true;
+  }
+
+  void Clear()
+  {
+    for(Shard &s : m_Shards)
+    {
+      SCOPED_WRITELOCK(s.lock);
+      s.map.clear();
+    }
+  }
+
+private:
+  static uint64_t RawID(ResourceId id)
+  {
+    static_assert(sizeof(ResourceId) == sizeof(uint64_t), "ResourceId is expected to be 64-bit");
+    uint64_t ret;
+    memcpy(&ret, &id, sizeof(ret));
+    return ret;
+  }
+
+  struct Hash
+  {
+    size_t operator()(ResourceId id) const
+    {
+      // the shard index already consumed the low bits, so mix in the rest
+      uint64_t raw = RawID(id) / ShardCount;
+      return size_t(raw ^ (raw >> 32));
+    }
+  };
+
+  struct Shard
+  {
+    mutable Threading::RWLock lock;
+    std::unordered_map<ResourceId, Value, Hash> map;
+  };
+
+  static void SortEntries(std::vector<Entry> &entries)
+  {
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry &a, const Entry &b) { return a.first < b.first; });
+  }
+
+  Shard &GetShard(ResourceId id) { return m_Shards[RawID(id) % ShardCount]; }
+  const Shard &GetShard(ResourceId id) const { return m_Shards[RawID(id) % ShardCount]; }
+  Shard m_Shards[ShardCount];
+};
@@ -0,0 +1,171 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+
+#include "sharded_map.h"
+#include "common/globalconfig.h"
+#include "core/resource_manager.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+
+TEST_CASE("Test sharded resource map", "[shardedmap]")
+{
+  std::vector<ResourceId> ids;
+  for(int i = 0; i < 100; i++)
+    ids.push_back(ResourceIDGen::GetNewUniqueID());
+
+  ShardedResourceMap<int> map;
+
+  CHECK(map.IsEmpty());
+  CHECK(map.Size() == 0);
+
+  SECTION("Insert, find and erase")
+  {
+    for(size_t i = 0; i < ids.size(); i++)
+      CHECK(map.Set(ids[i], int(i)));
+
+    CHECK(!map.IsEmpty());
+    CHECK(map.Size() == ids.size());
+
+    // overwriting doesn't count as a new insert
+    CHECK_FALSE(map.Set(ids[5], 500));
+
+    int val = -1;
+    CHECK(map.Find(ids[5], val));
+    CHECK(val == 500);
+    CHECK(map.Find(ids[6], val));
+    CHECK(val == 6);
+
+    val = -1;
+    CHECK_FALSE(map.Find(ResourceId(), val));
+    CHECK(val == -1);
+    CHECK_FALSE(map.Contains(ResourceId()));
+
+    CHECK(map.Erase(ids[6]));
+    CHECK_FALSE(map.Erase(ids[6]));
+    CHECK_FALSE(map.Contains(ids[6]));
+    CHECK(map.Size() == ids.size() - 1);
+
+    map.Clear();
+    CHECK(map.IsEmpty());
+    CHECK_FALSE(map.Contains(ids[5]));
+  };
+
+  SECTION("Apply")
+  {
+    CHECK(map.Apply(ids[0], [](int &v, bool isNew) {
+      CHECK(isNew);
+      CHECK(v == 0);
+      v = 10;
+    }));
+
+    CHECK_FALSE(map.Apply(ids[0], [](int &v, bool isNew) {
+      CHECK_FALSE(isNew);
+      CHECK(v == 10);
+      v++;
+    }));
+
+    int val = 0;
+    CHECK(map.Find(ids[0], val));
+    CHECK(val == 11);
+
+    map.Set(ids[1], 1);
+    map.Set(ids[2], 2);
+
+    map.ApplyAll([](ResourceId, int &v) { v *= 2; });
+
+    CHECK(map.Find(ids[0], val));
+    CHECK(val == 22);
+    CHECK(map.Find(ids[2], val));
+    CHECK(val == 4);
+  };
+
+  SECTION("Snapshots are sorted by ID")
+  {
+    // insert in reverse so the order can't come from insertion
+    for(size_t i = 0; i < ids.size(); i++)
+      map.Set(ids[ids.size() - 1 - i], int(ids.size() - 1 - i));
+
+    std::vector<ShardedResourceMap<int>::Entry> entries;
+    map.GetAll(entries);
+
+    REQUIRE(entries.size() == ids.size());
+    for(size_t i = 0; i < ids.size(); i++)
+    {
+      CHECK(entries[i].first == ids[i]);
+      CHECK(entries[i].second == int(i));
+    }
+
+    CHECK(map.Size() == ids.size());
+
+    map.TakeAll(entries);
+
+    CHECK(entries.size() == ids.size());
+    CHECK(entries.front().first == ids.front());
+    CHECK(entries.back().first == ids.back());
+    CHECK(map.IsEmpty());
+  };
+
+  SECTION("Concurrent access")
+  {
+    std::vector<Threading::ThreadHandle> threads;
+    threads.resize(8);
+
+    for(int t = 0; t < 8; t++)
+    {
+      threads[t] = Threading::CreateThread([&map, &ids, t]() {
+        // every thread counts every ID, and owns the insertion of every eighth one
+        for(size_t i = 0; i < ids.size(); i++)
+        {
+          map.Apply(ids[i], [](int &v, bool) { v++; });
+
+          if(i % 8 == size_t(t))
+            map.Set(ResourceIDGen::GetNewUniqueID(), -1);
+
+          int val = 0;
+          map.Find(ids[(i + 1) % ids.size()], val);
+        }
+      });
+    }
+
+    for(Threading::ThreadHandle t : threads)
+    {
+      Threading::JoinThread(t);
+      Threading::CloseThread(t);
+    }
+
+    CHECK(map.Size() == ids.size() * 2);
+
+    for(ResourceId id : ids)
+    {
+      int val = 0;
+      CHECK(map.Find(id, val));
+      CHECK(val == 8);
+    }
+  };
+};
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -131,13 +131,20 @@ void RenderDoc::TargetControlClientThread(uint32_t version, Network::Socket *cli
   }
 
   float captureProgress = -1.0f;
-  RenderDoc::Inst().SetProgressCallback<CaptureProgress>(
-      [&captureProgress](float p) { captureProgress = p; });
+  RenderDoc::Inst().SetProgressCallback<CaptureProgress>([&captureProgress](float p) {
+    // this is called for every resource processed, so only wake the thread for the first and last
+    // update of a capture. In between it wakes itself up at the rate-limited progress interval.
+    bool wake = (captureProgress == -1.0f || p == 1.0f);
+    captureProgress = p;
+    if(wake)
+      RenderDoc::Inst().NotifyTargetControl(RenderDoc::eNotify_Progress);
+  });
 
   const int pingtime = 1000;       // ping every 1000ms
-  const int ticktime = 10;         // tick every 10ms
   const int progresstime = 100;    // update capture progress every 100ms
-  int curtime = 0;
+
+  PerformanceTimer pingTimer;
+  PerformanceTimer progressTimer;
 
   std::vector<CaptureData> captures;
   std::vector<rdcpair<uint32_t, uint32_t> > children;
@@ -145,6 +152,9 @@ void RenderDoc::TargetControlClientThread(uint32_t version, Network::Socket *cli
   float prevCaptureProgress = captureProgress;
   uint32_t prevWindows = 0;
 
+  // on connection we need to send everything that's happened so far
+  int32_t pending = RenderDoc::eNotify_All;
+
   while(client)
   {
     if(RenderDoc::Inst().m_ControlClientThreadShutdown || (client && !client->Connected()))
@@ -153,102 +163,136 @@ void RenderDoc::TargetControlClientThread(uint32_t version, Network::Socket *cli
       break;
     }
 
-    Threading::Sleep(ticktime);
-    curtime += ticktime;
+    // sleep until the client sends us something, some state changes, or we need to ping. While a
+    // capture is in progress we also wake up whenever the next progress update is due.
+    if(pending == 0 && reader.GetReader()->AtEnd())
+    {
+      double timeout = pingtime - pingTimer.GetMilliseconds();
+      if(prevCaptureProgress != captureProgress || captureProgress != -1.0f)
+        timeout = RDCMIN(timeout, progresstime - progressTimer.GetMilliseconds());
 
-    std::map<RDCDriver, bool> curdrivers = RenderDoc::Inst().GetActiveDrivers();
+      if(timeout > 0.0)
+        client->Wait(RenderDoc::Inst().m_ControlClientWakeup, (uint32_t)timeout + 1);
+    }
 
-    std::vector<CaptureData> caps = RenderDoc::Inst().GetCaptures();
-    std::vector<rdcpair<uint32_t, uint32_t> > childprocs = RenderDoc::Inst().GetChildProcesses();
+    pending |= RenderDoc::Inst().ConsumeTargetControlNotifications();
 
-    uint32_t curWindows = RenderDoc::Inst().GetCapturableWindowCount();
+    // drivers stop being reported as presenting after a timeout rather than on any event, so
+    // re-check them whenever we ping
+    if(pingTimer.GetMilliseconds() > pingtime)
+      pending |= RenderDoc::eNotify_Drivers;
 
-    if(curdrivers != drivers)
+    if(pending & RenderDoc::eNotify_Drivers)
     {
-      // find the first difference, either a new key or a key with a different value, and send it.
-      RDCDriver driver = RDCDriver::Unknown;
-      bool presenting = false;
+      std::map<RDCDriver, bool> curdrivers = RenderDoc::Inst().GetActiveDrivers();
 
-      // search for new drivers
+      // send each new key or key with a different value
       for(auto it = curdrivers.begin(); it != curdrivers.end(); it++)
       {
-        if(drivers.find(it->first) == drivers.end() || drivers[it->first] != it->second)
-        {
-          driver = it->first;
-          presenting = it->second;
-          break;
-        }
-      }
+        auto prev = drivers.find(it->first);
+        if(prev != drivers.end() && prev->second == it->second)
+          continue;
 
-      RDCASSERTNOTEQUAL(driver, RDCDriver::Unknown);
+        RDCDriver driver = it->first;
+        bool presenting = it->second;
 
-      if(driver != RDCDriver::Unknown)
         drivers[driver] = presenting;
 
-      bool supported =
-          RenderDoc::Inst().HasRemoteDriver(driver) || RenderDoc::Inst().HasReplayDriver(driver);
+        bool supported =
+            RenderDoc::Inst().HasRemoteDriver(driver) || RenderDoc::Inst().HasReplayDriver(driver);
 
-      WRITE_DATA_SCOPE();
-      {
-        SCOPED_SERIALISE_CHUNK(ePacket_APIUse);
-        SERIALISE_ELEMENT(driver);
-        SERIALISE_ELEMENT(presenting);
-        SERIALISE_ELEMENT(supported);
+        WRITE_DATA_SCOPE();
+        {
+          SCOPED_SERIALISE_CHUNK(ePacket_APIUse);
+          SERIALISE_ELEMENT(driver);
+          SERIALISE_ELEMENT(presenting);
+          SERIALISE_ELEMENT(supported);
+        }
       }
     }
-    else if(caps.size() != captures.size())
+
+    if(pending & RenderDoc::eNotify_Captures)
     {
-      uint32_t idx = (uint32_t)captures.size();
+      std::vector<CaptureData> caps = RenderDoc::Inst().GetCaptures();
 
-      captures.push_back(caps[idx]);
+      for(uint32_t idx = (uint32_t)captures.size(); idx < caps.size(); idx++)
+      {
+        captures.push_back(caps[idx]);
 
-      std::string path = FileIO::GetFullPathname(captures.back().path);
+        std::string path = FileIO::GetFullPathname(captures.back().path);
 
-      bytebuf buf;
+        bytebuf buf;
 
-      ICaptureFile *file = RENDERDOC_OpenCaptureFile();
-      if(file->OpenFile(captures.back().path.c_str(), "rdc", NULL) == ReplayStatus::Succeeded)
-      {
-        buf = file->GetThumbnail(FileType::JPG, 0).data;
+        ICaptureFile *file = RENDERDOC_OpenCaptureFile();
+        if(file->OpenFile(captures.back().path.c_str(), "rdc", NULL) == ReplayStatus::Succeeded)
+        {
+          buf = file->GetThumbnail(FileType::JPG, 0).data;
+        }
+        file->Shutdown();
+
+        WRITE_DATA_SCOPE();
+        {
+          SCOPED_SERIALISE_CHUNK(ePacket_NewCapture);
+          SERIALISE_ELEMENT(idx);
+          SERIALISE_ELEMENT(captures.back().timestamp);
+          SERIALISE_ELEMENT(path);
+          SERIALISE_ELEMENT(buf);
+          if(version >= 3)
+            SERIALISE_ELEMENT(captures.back().driver);
+          if(version >= 5)
+            SERIALISE_ELEMENT(captures.back().frameNumber);
+        }
       }
-      file->Shutdown();
+    }
 
-      WRITE_DATA_SCOPE();
+    if(pending & RenderDoc::eNotify_Children)
+    {
+      std::vector<rdcpair<uint32_t, uint32_t> > childprocs = RenderDoc::Inst().GetChildProcesses();
+
+      for(size_t idx = children.size(); idx < childprocs.size(); idx++)
       {
-        SCOPED_SERIALISE_CHUNK(ePacket_NewCapture);
-        SERIALISE_ELEMENT(idx);
-        SERIALISE_ELEMENT(captures.back().timestamp);
-        SERIALISE_ELEMENT(path);
-        SERIALISE_ELEMENT(buf);
-        if(version >= 3)
-          SERIALISE_ELEMENT(captures.back().driver);
-        if(version >= 5)
-          SERIALISE_ELEMENT(captures.back().frameNumber);
+        children.push_back(childprocs[idx]);
+
+        WRITE_DATA_SCOPE();
+        {
+          SCOPED_SERIALISE_CHUNK(ePacket_NewChild);
+          SERIALISE_ELEMENT(children.back().first);
+          SERIALISE_ELEMENT(children.back().second);
+        }
       }
     }
-    else if(childprocs.size() != children.size())
-    {
-      uint32_t idx = (uint32_t)children.size();
 
-      children.push_back(childprocs[idx]);
+    if(version >= 4 && (pending & RenderDoc::eNotify_Windows))
+    {
+      uint32_t curWindows = RenderDoc::Inst().GetCapturableWindowCount();
 
-      WRITE_DATA_SCOPE();
+      if(prevWindows != curWindows)
       {
-        SCOPED_SERIALISE_CHUNK(ePacket_NewChild);
-        SERIALISE_ELEMENT(children.back().first);
-        SERIALISE_ELEMENT(children.back().second);
+        prevWindows = curWindows;
+
+        WRITE_DATA_SCOPE();
+        {
+          SCOPED_SERIALISE_CHUNK(ePacket_CapturableWindowCount);
+          SERIALISE_ELEMENT(curWindows);
+        }
       }
     }
-    else if(prevCaptureProgress != captureProgress)
+
+    pending = 0;
+
+    if(prevCaptureProgress != captureProgress)
     {
       if(captureProgress == 1.0f || captureProgress == -1.0f)
         captureProgress = -1.0f;
 
-      // send progress packets at reduced rate (not every tick), or if the progress is finished.
-      // we don't need to ping while we're sending capture progress, so we re-use curtime
-      if(captureProgress == -1.0f || curtime > progresstime)
+      // send progress packets at reduced rate (not on every update), or if the progress is
+      // finished. Otherwise we'll wake up again when the next update is due.
+      if(captureProgress == -1.0f || progressTimer.GetMilliseconds() > progresstime)
       {
-        curtime = 0;
+        progressTimer.Restart();
+
+        // we don't need to ping while we're sending capture progress
+        pingTimer.Restart();
 
         prevCaptureProgress = captureProgress;
 
@@ -259,24 +303,14 @@ void RenderDoc::TargetControlClientThread(uint32_t version, Network::Socket *cli
         }
       }
     }
-    else if(version >= 4 && prevWindows != curWindows)
-    {
-      prevWindows = curWindows;
 
-      WRITE_DATA_SCOPE();
-      {
-        SCOPED_SERIALISE_CHUNK(ePacket_CapturableWindowCount);
-        SERIALISE_ELEMENT(curWindows);
-      }
-    }
-
-    if(curtime > pingtime)
+    if(pingTimer.GetMilliseconds() > pingtime)
     {
       WRITE_DATA_SCOPE();
       {
         SCOPED_SERIALISE_CHUNK(ePacket_Noop);
       }
-      curtime = 0;
+      pingTimer.Restart();
     }
 
     if(writer.IsErrored())
@@ -322,7 +356,7 @@ void RenderDoc::TargetControlClientThread(uint32_t version, Network::Socket *cli
       }
       else if(type == ePacket_CopyCapture)
       {
-        caps = RenderDoc::Inst().GetCaptures();
+        std::vector<CaptureData> caps = RenderDoc::Inst().GetCaptures();
 
         uint32_t id;
 
@@ -377,12 +411,17 @@ void RenderDoc::TargetControlServerThread(Network::Socket *sock)
 
   RenderDoc::Inst().m_SingleClientName = "";
 
-  Threading::ThreadHandle clientThread = 0;
+  Threading::ThreadHandle &clientThread = RenderDoc::Inst().m_ControlClientThread;
 
   RenderDoc::Inst().m_ControlClientThreadShutdown = false;
 
   while(!RenderDoc::Inst().m_TargetControlThreadShutdown)
   {
+    // block until there's a pending connection or we're woken up to shut down. The timeout is
+    // only a safety net, we don't rely on it.
+    if(!sock->Wait(RenderDoc::Inst().m_TargetControlWakeup, 1000))
+      continue;
+
     Network::Socket *client = sock->AcceptClient(0);
 
     if(client == NULL)
@@ -396,8 +435,6 @@ void RenderDoc::TargetControlServerThread(Network::Socket *sock)
         return;
       }
 
-      Threading::Sleep(5);
-
       continue;
     }
 
@@ -442,6 +479,7 @@ void RenderDoc::TargetControlServerThread(Network::Socket *sock)
     {
       // forcibly close communication thread which will kill the connection
       RenderDoc::Inst().m_ControlClientThreadShutdown = true;
+      RenderDoc::Inst().m_ControlClientWakeup->Signal();
       Threading::JoinThread(clientThread);
       Threading::CloseThread(clientThread);
       clientThread = 0;
@@ -484,9 +522,15 @@ void RenderDoc::TargetControlServerThread(Network::Socket *sock)
   }
 
   RenderDoc::Inst().m_ControlClientThreadShutdown = true;
-  // don't join, just close the thread, as we can't wait while in the middle of module unloading
-  Threading::CloseThread(clientThread);
-  clientThread = 0;
+  RenderDoc::Inst().m_ControlClientWakeup->Signal();
+  // on an explicit Shutdown() the client thread is joined there so that its wakeup can be freed.
+  // Otherwise don't join, just close the thread, as we can't wait while in the middle of module
+  // unloading
+  if(!RenderDoc::Inst().m_TargetControlJoinClient)
+  {
+    Threading::CloseThread(clientThread);
+    clientThread = 0;
+  }
 
   SAFE_DELETE(sock);
 
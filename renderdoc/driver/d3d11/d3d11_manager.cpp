@@ -61,7 +61,10 @@ void D3D11ResourceManager::SetInternalResource(ID3D11DeviceChild *res)
 
 void D3D11ResourceManager::FreeCaptureData()
 {
-  for(auto it = m_ResourceRecords.begin(); it != m_ResourceRecords.end(); ++it)
+  std::vector<std::pair<ResourceId, D3D11ResourceRecord *>> records;
+  m_ResourceRecords.GetAll(records);
+
+  for(auto it = records.begin(); it != records.end(); ++it)
   {
     D3D11ResourceRecord *record = it->second;
 
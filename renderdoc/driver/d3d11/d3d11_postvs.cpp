@@ -95,6 +95,9 @@ void D3D11Replay::ClearPostVSCache()
   }
 
   m_PostVSData.clear();
+
+  // post-transform buffers can be reused, so any BVH built from them is stale
+  m_PickCache.Clear();
 }
 
 MeshFormat D3D11Replay::GetPostVSBuffers(uint32_t eventId, uint32_t instID, uint32_t viewID,
@@ -55,6 +55,7 @@ D3D11Replay::D3D11Replay()
   m_WARP = false;
 
   m_HighlightCache.driver = this;
+  m_PickCache.driver = this;
 
   RDCEraseEl(m_DriverInfo);
 }
@@ -566,6 +567,11 @@ rdcarray<GPUDevice> D3D11Replay::GetAvailableGPUs()
   return ret;
 }
 
+InitialStateRestoreStats D3D11Replay::GetInitialStateRestoreStats()
+{
+  return m_pDevice->GetResourceManager()->GetInitialStateRestoreStats();
+}
+
 APIProperties D3D11Replay::GetAPIProperties()
 {
   APIProperties ret = m_pDevice->APIProps;
@@ -2753,6 +2759,15 @@ uint32_t D3D11Replay::PickVertex(uint32_t eventId, int32_t width, int32_t height
     }
   }
 
+  // once a BVH has been built for a triangle mesh, pick on the CPU instead
+  {
+    uint32_t vertid = ~0U;
+    if(m_PickCache.PickTriangles(eventId, cfg, false, rayPos, rayDir, vertid))
+    {
+      return vertid;
+    }
+  }
+
   cbuf.PickRayPos = rayPos;
   cbuf.PickRayDir = rayDir;
 
@@ -106,6 +106,7 @@ public:
 
   DriverInformation GetDriverInfo() { return m_DriverInfo; }
   rdcarray<GPUDevice> GetAvailableGPUs();
+  InitialStateRestoreStats GetInitialStateRestoreStats();
   APIProperties GetAPIProperties();
 
   ResourceDescription &GetResourceDesc(ResourceId id);
@@ -335,6 +336,7 @@ private:
   std::map<uint32_t, D3D11PostVSData> m_PostVSData;
 
   HighlightCache m_HighlightCache;
+  MeshPickCache m_PickCache;
 
   uint64_t m_SOBufferSize = 32 * 1024 * 1024;
   ID3D11Buffer *m_SOBuffer = NULL;
@@ -46,6 +46,8 @@ struct D3D12QuadOverdrawCallback : public D3D12DrawcallCallback
                             const std::vector<uint32_t> &events, PortableHandle uav)
       : m_pDevice(dev), m_QuadWritePS(quadWrite), m_Events(events), m_UAV(uav)
   {
+    // sorted for lookup, large passes can contain thousands of draws
+    std::sort(m_Events.begin(), m_Events.end());
     m_pDevice->GetQueue()->GetCommandData()->m_DrawcallCallback = this;
   }
   ~D3D12QuadOverdrawCallback()
@@ -54,7 +56,7 @@ struct D3D12QuadOverdrawCallback : public D3D12DrawcallCallback
   }
   void PreDraw(uint32_t eid, ID3D12GraphicsCommandListX *cmd)
   {
-    if(std::find(m_Events.begin(), m_Events.end(), eid) == m_Events.end())
+    if(!std::binary_search(m_Events.begin(), m_Events.end(), eid))
       return;
 
     // we customise the pipeline to disable framebuffer writes, but perform normal testing
@@ -223,7 +225,7 @@ struct D3D12QuadOverdrawCallback : public D3D12DrawcallCallback
 
   bool PostDraw(uint32_t eid, ID3D12GraphicsCommandListX *cmd)
   {
-    if(std::find(m_Events.begin(), m_Events.end(), eid) == m_Events.end())
+    if(!std::binary_search(m_Events.begin(), m_Events.end(), eid))
       return false;
 
     // restore the render state and go ahead with the real draw
@@ -252,7 +254,7 @@ struct D3D12QuadOverdrawCallback : public D3D12DrawcallCallback
 
   WrappedID3D12Device *m_pDevice;
   D3D12_SHADER_BYTECODE m_QuadWritePS;
-  const std::vector<uint32_t> &m_Events;
+  std::vector<uint32_t> m_Events;
   PortableHandle m_UAV;
 
   // cache modified pipelines
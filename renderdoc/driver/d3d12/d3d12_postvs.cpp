@@ -152,6 +152,9 @@ void D3D12Replay::ClearPostVSCache()
   }
 
   m_PostVSData.clear();
+
+  // post-transform buffers can be reused, so any BVH built from them is stale
+  m_PickCache.Clear();
 }
 
 void D3D12Replay::InitPostVSBuffers(uint32_t eventId)
@@ -1338,12 +1341,14 @@ struct D3D12InitPostVSCallback : public D3D12DrawcallCallback
                           const std::vector<uint32_t> &events)
       : m_pDevice(dev), m_Replay(replay), m_Events(events)
   {
+    // sorted for lookup, large passes can contain thousands of draws
+    std::sort(m_Events.begin(), m_Events.end());
     m_pDevice->GetQueue()->GetCommandData()->m_DrawcallCallback = this;
   }
   ~D3D12InitPostVSCallback() { m_pDevice->GetQueue()->GetCommandData()->m_DrawcallCallback = NULL; }
   void PreDraw(uint32_t eid, ID3D12GraphicsCommandListX *cmd) override
   {
-    if(std::find(m_Events.begin(), m_Events.end(), eid) != m_Events.end())
+    if(std::binary_search(m_Events.begin(), m_Events.end(), eid))
       m_Replay->InitPostVSBuffers(eid);
   }
 
@@ -1356,13 +1361,13 @@ struct D3D12InitPostVSCallback : public D3D12DrawcallCallback
   void PreCloseCommandList(ID3D12GraphicsCommandListX *cmd) override {}
   void AliasEvent(uint32_t primary, uint32_t alias) override
   {
-    if(std::find(m_Events.begin(), m_Events.end(), primary) != m_Events.end())
+    if(std::binary_search(m_Events.begin(), m_Events.end(), primary))
       m_Replay->AliasPostVSBuffers(primary, alias);
   }
 
   WrappedID3D12Device *m_pDevice;
   D3D12Replay *m_Replay;
-  const std::vector<uint32_t> &m_Events;
+  std::vector<uint32_t> m_Events;
 };
 
 void D3D12Replay::InitPostVSBuffers(const std::vector<uint32_t> &events)
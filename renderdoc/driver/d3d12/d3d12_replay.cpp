@@ -87,6 +87,7 @@ D3D12Replay::D3D12Replay()
   m_Proxy = false;
 
   m_HighlightCache.driver = this;
+  m_PickCache.driver = this;
 
   RDCEraseEl(m_DriverInfo);
 }
@@ -263,6 +264,11 @@ rdcarray<GPUDevice> D3D12Replay::GetAvailableGPUs()
   return ret;
 }
 
+InitialStateRestoreStats D3D12Replay::GetInitialStateRestoreStats()
+{
+  return m_pDevice->GetResourceManager()->GetInitialStateRestoreStats();
+}
+
 APIProperties D3D12Replay::GetAPIProperties()
 {
   APIProperties ret = m_pDevice->APIProps;
@@ -1875,6 +1881,15 @@ uint32_t D3D12Replay::PickVertex(uint32_t eventId, int32_t width, int32_t height
     }
   }
 
+  // once a BVH has been built for a triangle mesh, pick on the CPU instead
+  {
+    uint32_t vertid = ~0U;
+    if(m_PickCache.PickTriangles(eventId, cfg, false, rayPos, rayDir, vertid))
+    {
+      return vertid;
+    }
+  }
+
   cbuf.PickRayPos = rayPos;
   cbuf.PickRayDir = rayDir;
 
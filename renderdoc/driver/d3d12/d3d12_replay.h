@@ -66,6 +66,7 @@ public:
   void DestroyResources();
   DriverInformation GetDriverInfo() { return m_DriverInfo; }
   rdcarray<GPUDevice> GetAvailableGPUs();
+  InitialStateRestoreStats GetInitialStateRestoreStats();
   APIProperties GetAPIProperties();
 
   ResourceDescription &GetResourceDesc(ResourceId id);
@@ -327,6 +328,7 @@ private:
   std::map<uint64_t, OutputWindow> m_OutputWindows;
 
   HighlightCache m_HighlightCache;
+  MeshPickCache m_PickCache;
 
   ID3D12Resource *m_CustomShaderTex = NULL;
   ResourceId m_CustomShaderResourceId;
@@ -86,7 +86,7 @@ CGLError GL_EXPORT_NAME(CGLCreateContext)(CGLPixelFormatObj pix, CGLContextObj s
   data.pix = pix;
 
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
     cglhook.driver.CreateContext(data, share, init, isCore, isCore);
   }
 
@@ -110,7 +110,7 @@ CGLError GL_EXPORT_NAME(CGLSetCurrentContext)(CGLContextObj ctx)
 
   if(ret == kCGLNoError)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     SetDriverForHooks(&cglhook.driver);
 
@@ -170,7 +170,7 @@ CGLError GL_EXPORT_NAME(CGLFlushDrawable)(CGLContextObj ctx)
   }
 
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     CGSConnectionID conn = 0;
     CGSWindowID window = 0;
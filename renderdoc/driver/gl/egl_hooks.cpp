@@ -329,7 +329,7 @@ HOOK_EXPORT EGLContext EGLAPIENTRY eglCreateContext_renderdoc_hooked(EGLDisplay
   EnableGLHooks();
   eglhook.driver.SetDriverType(eglhook.activeAPI);
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
     eglhook.driver.CreateContext(data, shareContext, init, true, true);
   }
 
@@ -350,7 +350,7 @@ HOOK_EXPORT EGLBoolean EGLAPIENTRY eglDestroyContext_renderdoc_hooked(EGLDisplay
 
   eglhook.driver.SetDriverType(eglhook.activeAPI);
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
     eglhook.driver.DeleteContext(ctx);
     eglhook.contexts.erase(ctx);
   }
@@ -377,7 +377,7 @@ HOOK_EXPORT EGLSurface EGLAPIENTRY eglCreateWindowSurface_renderdoc_hooked(EGLDi
 
   if(ret)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     // spec says it's implementation dependent what happens, so we assume that we're using the same
     // window system as the display
@@ -404,7 +404,7 @@ HOOK_EXPORT EGLSurface EGLAPIENTRY eglCreatePlatformWindowSurface_renderdoc_hook
 
   if(ret)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     // spec guarantees that we're using the same window system as the display
     eglhook.windows[ret] = {eglhook.displays[dpy].system, native_window};
@@ -431,7 +431,7 @@ HOOK_EXPORT EGLBoolean EGLAPIENTRY eglMakeCurrent_renderdoc_hooked(EGLDisplay di
 
   if(ret)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     SetDriverForHooks(&eglhook.driver);
 
@@ -488,7 +488,7 @@ HOOK_EXPORT EGLBoolean EGLAPIENTRY eglSwapBuffers_renderdoc_hooked(EGLDisplay dp
 
   EnsureRealLibraryLoaded();
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   eglhook.driver.SetDriverType(eglhook.activeAPI);
   if(!eglhook.driver.UsesVRFrameMarkers() && !eglhook.swapping)
@@ -528,7 +528,7 @@ HOOK_EXPORT EGLBoolean EGLAPIENTRY eglPostSubBufferNV_renderdoc_hooked(EGLDispla
 
   EnsureRealLibraryLoaded();
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   eglhook.driver.SetDriverType(eglhook.activeAPI);
   if(!eglhook.driver.UsesVRFrameMarkers() && !eglhook.swapping)
@@ -561,7 +561,7 @@ HOOK_EXPORT EGLBoolean EGLAPIENTRY eglSwapBuffersWithDamageEXT_renderdoc_hooked(
 
   EnsureRealLibraryLoaded();
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   eglhook.driver.SetDriverType(eglhook.activeAPI);
   if(!eglhook.driver.UsesVRFrameMarkers() && !eglhook.swapping)
@@ -594,7 +594,7 @@ HOOK_EXPORT EGLBoolean EGLAPIENTRY eglSwapBuffersWithDamageKHR_renderdoc_hooked(
 
   EnsureRealLibraryLoaded();
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   eglhook.driver.SetDriverType(eglhook.activeAPI);
   if(!eglhook.driver.UsesVRFrameMarkers() && !eglhook.swapping)
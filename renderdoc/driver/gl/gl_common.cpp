@@ -29,11 +29,49 @@
 #include "gl_dispatch_table.h"
 #include "gl_driver.h"
 
-Threading::CriticalSection glLock;
+GLLock glLock;
+
+thread_local int32_t GLLock::m_ExclusiveDepth = 0;
+thread_local int32_t GLLock::m_SharedDepth = 0;
+
+void GLLock::Lock()
+{
+  // a rwlock can't be upgraded, so this would deadlock
+  RDCASSERTMSG("GL lock taken exclusively while held shared", m_SharedDepth == 0);
+
+  if(m_ExclusiveDepth++ == 0)
+    m_RWLock.WriteLock();
+}
+
+void GLLock::Unlock()
+{
+  if(--m_ExclusiveDepth == 0)
+    m_RWLock.WriteUnlock();
+}
+
+bool GLLock::LockShared()
+{
+  if(m_ExclusiveDepth > 0)
+  {
+    Lock();
+    return false;
+  }
+
+  if(m_SharedDepth++ == 0)
+    m_RWLock.ReadLock();
+
+  return true;
+}
+
+void GLLock::UnlockShared()
+{
+  if(--m_SharedDepth == 0)
+    m_RWLock.ReadUnlock();
+}
 
 GLDispatchTable GL = {};
 
-GLChunk gl_CurChunk = GLChunk::Max;
+thread_local GLChunk gl_CurChunk = GLChunk::Max;
 
 bool HasExt[GLExtension_Count] = {};
 bool VendorCheck[VendorCheck_Count] = {};
@@ -409,14 +409,16 @@ T CheckConstParam(T t);
   template bool WrappedOpenGL::CONCAT(Serialise_, func(ReadSerialiser &ser, ##__VA_ARGS__)); \
   template bool WrappedOpenGL::CONCAT(Serialise_, func(WriteSerialiser &ser, ##__VA_ARGS__));
 
-#define USE_SCRATCH_SERIALISER() WriteSerialiser &ser = m_ScratchSerialiser;
-
-#define SERIALISE_TIME_CALL(...)                                                                    \
-  m_ScratchSerialiser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp(); \
-  __VA_ARGS__;                                                                                      \
-  m_ScratchSerialiser.ChunkMetadata().durationMicro =                                               \
-      RenderDoc::Inst().GetMicrosecondTimestamp() -                                                 \
-      m_ScratchSerialiser.ChunkMetadata().timestampMicro;
+#define USE_SCRATCH_SERIALISER() WriteSerialiser &ser = GetThreadSerialiser();
+
+#define SERIALISE_TIME_CALL(...)                                                          \
+  {                                                                                       \
+    WriteSerialiser &ser = GetThreadSerialiser();                                         \
+    ser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();     \
+    __VA_ARGS__;                                                                          \
+    ser.ChunkMetadata().durationMicro =                                                   \
+        RenderDoc::Inst().GetMicrosecondTimestamp() - ser.ChunkMetadata().timestampMicro; \
+  }
 
 // A handy macros to say "is the serialiser reading and we're doing replay-mode stuff?"
 // The reason we check both is that checking the first allows the compiler to eliminate the other
@@ -445,7 +447,40 @@ const GLenum eGL_CLAMP = (GLenum)0x2900;
 const GLenum eGL_ZERO = (GLenum)0;
 const GLenum eGL_ONE = (GLenum)1;
 
-extern Threading::CriticalSection glLock;
+// Lock around all calls into the driver from the hooks. Anything that can change global tracking
+// state takes it exclusively, and that is recursive since hooks can re-enter, e.g. SwapBuffers
+// starting or ending a capture. While background capturing a few very frequent hooks that only
+// touch their own context's state or internally locked tracking take it shared instead, so that
+// threads on different contexts can run them at the same time. See SCOPED_GLCALL in gl_hooks.cpp.
+class GLLock
+{
+public:
+  void Lock();
+  void Unlock();
+
+  // takes the lock shared, unless this thread already holds it exclusively in which case that is
+  // recursed into instead. Returns true if the lock was taken shared.
+  bool LockShared();
+  void UnlockShared();
+
+private:
+  Threading::RWLock m_RWLock;
+
+  // how many times the current thread has taken the lock in each mode
+  static thread_local int32_t m_ExclusiveDepth;
+  static thread_local int32_t m_SharedDepth;
+};
+
+extern GLLock glLock;
+
+struct ScopedGLLock
+{
+  ScopedGLLock(GLLock &l) : lock(l) { lock.Lock(); }
+  ~ScopedGLLock() { lock.Unlock(); }
+  GLLock &lock;
+};
+
+#define SCOPED_GLLOCK() ScopedGLLock CONCAT(scopedgllock, __LINE__)(glLock);
 
 // replay only class for handling marker regions
 struct GLMarkerRegion
@@ -730,6 +765,8 @@ extern bool IsGLES;
   EXT_TO_CHECK(46, 99, ARB_pipeline_statistics_query)            \
   EXT_TO_CHECK(46, 99, ARB_gl_spirv)                             \
   EXT_TO_CHECK(99, 99, ARB_indirect_parameters)                  \
+  EXT_TO_CHECK(99, 99, ARB_parallel_shader_compile)              \
+  EXT_TO_CHECK(99, 99, KHR_parallel_shader_compile)              \
   EXT_TO_CHECK(99, 99, ARB_seamless_cubemap_per_texture)         \
   EXT_TO_CHECK(99, 99, EXT_depth_bounds_test)                    \
   EXT_TO_CHECK(99, 99, EXT_direct_state_access)                  \
@@ -2178,7 +2215,7 @@ private:
 };
 
 // set at the point of each hooked entry point, so we know precisely which function was called
-extern GLChunk gl_CurChunk;
+extern thread_local GLChunk gl_CurChunk;
 
 #define PUSH_CURRENT_CHUNK GLChunkPreserver _chunk_restore(gl_CurChunk)
 
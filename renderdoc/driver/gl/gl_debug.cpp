@@ -336,6 +336,7 @@ void GLReplay::InitDebugData()
   m_pDriver->PushInternalShader();
 
   m_HighlightCache.driver = m_pDriver->GetReplay();
+  m_PickCache.driver = m_pDriver->GetReplay();
 
   RenderDoc::Inst().SetProgress(LoadProgress::DebugManagerInit, 0.0f);
 
@@ -1950,6 +1951,15 @@ uint32_t GLReplay::PickVertex(uint32_t eventId, int32_t width, int32_t height,
     }
   }
 
+  // once a BVH has been built for a triangle mesh, pick on the CPU instead
+  {
+    uint32_t vertid = ~0U;
+    if(m_PickCache.PickTriangles(eventId, cfg, false, rayPos, rayDir, vertid))
+    {
+      return vertid;
+    }
+  }
+
   GLuint ib = 0;
 
   uint32_t minIndex = 0;
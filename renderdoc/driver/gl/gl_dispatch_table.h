@@ -46,6 +46,12 @@ struct GLDispatchTable
   void EmulateRequiredExtensions();
   void DriverForEmulation(WrappedOpenGL *driver);
 
+  // on replay, wraps bind and enable functions to keep a shadow copy of that state so that queries
+  // for it don't need to round-trip to the driver. Implemented in gl_shadowed.cpp
+  void ShadowReplayState(WrappedOpenGL *driver);
+  // forget any shadowed state for a context, when it's newly created
+  void ResetShadowedState(void *ctx);
+
   // first we list all the core functions. 1.1 functions are separate under 'dllexport' for
   // different handling on windows. Extensions come after.
   // Any Core functions that are semantically identical to extension variants are listed as
@@ -604,7 +604,7 @@ void WrappedOpenGL::BuildGLESExtensions()
 }
 
 WrappedOpenGL::WrappedOpenGL(GLPlatform &platform)
-    : m_Platform(platform), m_ScratchSerialiser(new StreamWriter(1024), Ownership::Stream)
+    : m_Platform(platform)
 {
   if(RenderDoc::Inst().GetCrashHandler())
     RenderDoc::Inst().GetCrashHandler()->RegisterMemoryRegion(this, sizeof(WrappedOpenGL));
@@ -618,14 +618,7 @@ WrappedOpenGL::WrappedOpenGL(GLPlatform &platform)
 
   m_StructuredFile = &m_StoredStructuredData;
 
-  uint32_t flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
-                   WriteSerialiser::ChunkThreadID;
-
-  if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
-    flags |= WriteSerialiser::ChunkCallstack;
-
-  m_ScratchSerialiser.SetChunkMetadataRecording(flags);
-  m_ScratchSerialiser.SetVersion(GLInitParams::CurrentVersion);
+  m_ThreadSerialiserTLSSlot = Threading::AllocateTLSSlot();
 
   m_SectionVersion = GLInitParams::CurrentVersion;
 
@@ -673,8 +666,6 @@ WrappedOpenGL::WrappedOpenGL(GLPlatform &platform)
 
   m_ResourceManager = new GLResourceManager(m_State, this);
 
-  m_ScratchSerialiser.SetUserData(GetResourceManager());
-
   m_DeviceResourceID =
       GetResourceManager()->RegisterResource(GLResource(NULL, eResSpecial, eSpecialResDevice));
   m_ContextResourceID =
@@ -962,13 +953,16 @@ WrappedOpenGL::~WrappedOpenGL()
   for(size_t i = 0; i < m_CtxDataVector.size(); i++)
     delete m_CtxDataVector[i];
 
+  for(size_t i = 0; i < m_ThreadSerialisers.size(); i++)
+    delete m_ThreadSerialisers[i];
+
   if(RenderDoc::Inst().GetCrashHandler())
     RenderDoc::Inst().GetCrashHandler()->UnregisterMemoryRegion(this);
 }
 
 ContextPair &WrappedOpenGL::GetCtx()
 {
-  GLContextTLSData *ret = (GLContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
+  ContextTLSData *ret = (ContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
   if(ret)
     return ret->ctxPair;
   return m_EmptyTLSData.ctxPair;
@@ -976,21 +970,54 @@ ContextPair &WrappedOpenGL::GetCtx()
 
 GLResourceRecord *WrappedOpenGL::GetContextRecord()
 {
-  GLContextTLSData *ret = (GLContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
+  ContextTLSData *ret = (ContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
   if(ret && ret->ctxRecord)
-  {
     return ret->ctxRecord;
-  }
-  else
+
+  ContextData &dat = GetCtxData();
+  dat.CreateResourceRecord(this, GetCtx().ctx);
+
+  // cache the new record so only the first call on this thread goes through here
+  if(ret && ret->ctxData == &dat)
+    ret->ctxRecord = dat.m_ContextDataRecord;
+
+  return dat.m_ContextDataRecord;
+}
+
+WriteSerialiser &WrappedOpenGL::GetThreadSerialiser()
+{
+  WriteSerialiser *ser = (WriteSerialiser *)Threading::GetTLSValue(m_ThreadSerialiserTLSSlot);
+  if(ser)
+    return *ser;
+
+  // slow path, but rare
+  ser = new WriteSerialiser(new StreamWriter(1024), Ownership::Stream);
+
+  uint32_t flags = WriteSerialiser::ChunkDuration | WriteSerialiser::ChunkTimestamp |
+                   WriteSerialiser::ChunkThreadID;
+
+  if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
+    flags |= WriteSerialiser::ChunkCallstack;
+
+  ser->SetChunkMetadataRecording(flags);
+  ser->SetUserData(GetResourceManager());
+  ser->SetVersion(GLInitParams::CurrentVersion);
+
+  Threading::SetTLSValue(m_ThreadSerialiserTLSSlot, (void *)ser);
+
   {
-    ContextData &dat = GetCtxData();
-    dat.CreateResourceRecord(this, GetCtx().ctx);
-    return dat.m_ContextDataRecord;
+    SCOPED_LOCK(m_ThreadSerialisersLock);
+    m_ThreadSerialisers.push_back(ser);
   }
+
+  return *ser;
 }
 
 WrappedOpenGL::ContextData &WrappedOpenGL::GetCtxData()
 {
+  ContextTLSData *ret = (ContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
+  if(ret && ret->ctxData)
+    return *ret->ctxData;
   return m_ContextData[GetCtx().ctx];
 }
 
@@ -1002,6 +1029,17 @@ void WrappedOpenGL::DeleteContext(void *contextHandle)
 {
   ContextData &ctxdata = m_ContextData[contextHandle];
 
+  // any thread that still has this context cached must go back to looking it up, since we're about
+  // to erase it.
+  for(ContextTLSData *tlsData : m_CtxDataVector)
+  {
+    if(tlsData->ctxData == &ctxdata)
+    {
+      tlsData->ctxData = NULL;
+      tlsData->ctxRecord = NULL;
+    }
+  }
+
   RenderDoc::Inst().RemoveDeviceFrameCapturer(ctxdata.ctx);
 
   // delete the context
@@ -1139,14 +1177,18 @@ void WrappedOpenGL::CreateContext(GLWindowingData winData, void *shareContext,
   RenderDoc::Inst().AddDeviceFrameCapturer(ctxdata.ctx, this);
 
   // re-configure callstack capture, since WrappedOpenGL constructor may run too early
-  uint32_t flags = m_ScratchSerialiser.GetChunkMetadataRecording();
+  SCOPED_LOCK(m_ThreadSerialisersLock);
+  for(WriteSerialiser *ser : m_ThreadSerialisers)
+  {
+    uint32_t flags = ser->GetChunkMetadataRecording();
 
-  if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
-    flags |= WriteSerialiser::ChunkCallstack;
-  else
-    flags &= ~WriteSerialiser::ChunkCallstack;
+    if(RenderDoc::Inst().GetCaptureOptions().captureCallstacks)
+      flags |= WriteSerialiser::ChunkCallstack;
+    else
+      flags &= ~WriteSerialiser::ChunkCallstack;
 
-  m_ScratchSerialiser.SetChunkMetadataRecording(flags);
+    ser->SetChunkMetadataRecording(flags);
+  }
 }
 
 bool WrappedOpenGL::ForceSharedObjects(void *oldContext, void *newContext)
@@ -1170,6 +1212,9 @@ bool WrappedOpenGL::ForceSharedObjects(void *oldContext, void *newContext)
 void WrappedOpenGL::RegisterReplayContext(GLWindowingData winData, void *shareContext, bool core,
                                           bool attribsCreate)
 {
+  // a new context can be at the address of one that was destroyed
+  GL.ResetShadowedState(winData.ctx);
+
   ContextData &ctxdata = m_ContextData[winData.ctx];
   ctxdata.ctx = winData.ctx;
   ctxdata.isCore = core;
@@ -1314,17 +1359,18 @@ void WrappedOpenGL::ActivateContext(GLWindowingData winData)
 
     // update thread-local context pair
     {
-      GLContextTLSData *tlsData = (GLContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
+      ContextTLSData *tlsData = (ContextTLSData *)Threading::GetTLSValue(m_CurCtxDataTLS);
 
       if(tlsData)
       {
         tlsData->ctxPair = {winData.ctx, ShareCtx(winData.ctx)};
         tlsData->ctxRecord = ctxdata.m_ContextDataRecord;
+        tlsData->ctxData = &ctxdata;
       }
       else
       {
-        tlsData = new GLContextTLSData(ContextPair({winData.ctx, ShareCtx(winData.ctx)}),
-                                       ctxdata.m_ContextDataRecord);
+        tlsData = new ContextTLSData(ContextPair({winData.ctx, ShareCtx(winData.ctx)}),
+                                       ctxdata.m_ContextDataRecord, &ctxdata);
         m_CtxDataVector.push_back(tlsData);
 
         Threading::SetTLSValue(m_CurCtxDataTLS, tlsData);
@@ -2118,7 +2164,7 @@ void WrappedOpenGL::StartFrameCapture(void *dev, void *wnd)
   if(!IsBackgroundCapturing(m_State))
     return;
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   m_State = CaptureState::ActiveCapturing;
 
@@ -2175,7 +2221,7 @@ bool WrappedOpenGL::EndFrameCapture(void *dev, void *wnd)
   if(!IsActiveCapturing(m_State))
     return true;
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   CaptureFailReason reason = CaptureSucceeded;
 
@@ -2244,7 +2290,7 @@ bool WrappedOpenGL::EndFrameCapture(void *dev, void *wnd)
     {
       WriteSerialiser ser(captureWriter, Ownership::Stream);
 
-      ser.SetChunkMetadataRecording(m_ScratchSerialiser.GetChunkMetadataRecording());
+      ser.SetChunkMetadataRecording(GetThreadSerialiser().GetChunkMetadataRecording());
 
       ser.SetUserData(GetResourceManager());
 
@@ -2343,6 +2389,7 @@ bool WrappedOpenGL::EndFrameCapture(void *dev, void *wnd)
     GetResourceManager()->ClearReferencedResources();
 
     GetResourceManager()->FreeInitialContents();
+    GetResourceManager()->ReleaseTextureReadbacks();
 
     for(auto it = m_CoherentMaps.begin(); it != m_CoherentMaps.end(); ++it)
     {
@@ -2393,6 +2440,7 @@ bool WrappedOpenGL::EndFrameCapture(void *dev, void *wnd)
     GetResourceManager()->ClearReferencedResources();
 
     GetResourceManager()->FreeInitialContents();
+    GetResourceManager()->ReleaseTextureReadbacks();
 
     for(auto it = m_CoherentMaps.begin(); it != m_CoherentMaps.end(); ++it)
     {
@@ -2451,7 +2499,7 @@ bool WrappedOpenGL::DiscardFrameCapture(void *dev, void *wnd)
   if(!IsActiveCapturing(m_State))
     return true;
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   RenderDoc::Inst().FinishCaptureWriting(NULL, m_CapturedFrames.back().frameNumber);
 
@@ -2460,6 +2508,7 @@ bool WrappedOpenGL::DiscardFrameCapture(void *dev, void *wnd)
   GetResourceManager()->ClearReferencedResources();
 
   GetResourceManager()->FreeInitialContents();
+  GetResourceManager()->ReleaseTextureReadbacks();
 
   FinishCapture();
 
@@ -3053,6 +3102,12 @@ ReplayStatus WrappedOpenGL::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
 
   uint64_t frameDataSize = 0;
 
+  // shader compiles are issued ahead of processing their results while loading, let the driver use
+  // as many threads as it wants for them. 0xFFFFFFFF requests the implementation's maximum.
+  if(IsReplayMode(m_State) && GL.glMaxShaderCompilerThreadsKHR &&
+     (HasExt[KHR_parallel_shader_compile] || HasExt[ARB_parallel_shader_compile]))
+    GL.glMaxShaderCompilerThreadsKHR(0xFFFFFFFFU);
+
   for(;;)
   {
     PerformanceTimer timer;
@@ -3066,6 +3121,12 @@ ReplayStatus WrappedOpenGL::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
     if(reader->IsErrored())
       return ReplayStatus::APIDataCorrupted;
 
+    // initial contents and the frame itself need shader reflection, so any compiles still in flight
+    // must be finished by then.
+    if((SystemChunk)context == SystemChunk::InitialContents ||
+       (SystemChunk)context == SystemChunk::CaptureScope)
+      FlushPendingShaderCompiles();
+
     bool success = ProcessChunk(ser, context);
 
     ser.EndChunk();
@@ -3117,6 +3178,9 @@ ReplayStatus WrappedOpenGL::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
       break;
   }
 
+  // a capture with no frame in it won't have flushed above
+  FlushPendingShaderCompiles();
+
 #if ENABLED(RDOC_DEVEL)
   for(auto it = chunkInfos.begin(); it != chunkInfos.end(); ++it)
   {
@@ -121,7 +121,8 @@ private:
   CaptureState m_State;
   bool m_AppControlledCapture;
 
-  bool m_MarkedActive = false;
+  // set once by CoherentMapImplicitBarrier, which can run concurrently from shared-lock hooks
+  volatile int32_t m_MarkedActive = 0;
 
   bool m_UsesVRMarkers;
 
@@ -132,17 +133,15 @@ private:
   GLInitParams m_GlobalInitParams;
   ReplayOptions m_ReplayOptions;
 
-  WriteSerialiser m_ScratchSerialiser;
+  uint64_t m_ThreadSerialiserTLSSlot;
+  Threading::CriticalSection m_ThreadSerialisersLock;
+  std::vector<WriteSerialiser *> m_ThreadSerialisers;
   std::set<std::string> m_StringDB;
 
   StreamReader *m_FrameReader = NULL;
 
   static std::map<uint64_t, GLWindowingData> m_ActiveContexts;
 
-  GLContextTLSData m_EmptyTLSData;
-  uint64_t m_CurCtxDataTLS;
-  std::vector<GLContextTLSData *> m_CtxDataVector;
-
   uintptr_t m_ShareGroupID;
 
   uint32_t m_InternalShader = 0;
@@ -191,7 +190,7 @@ private:
   CaptureFailReason m_FailureReason;
   bool m_SuccessfulCapture;
 
-  std::set<ResourceId> m_HighTrafficResources;
+  ShardedResourceMap<bool> m_HighTrafficResources;
 
   int m_ReplayEventCount = 0;
 
@@ -215,11 +214,8 @@ private:
     if(m_State == CaptureState::ActiveCapturing && !m_CoherentMaps.empty())
       PersistentMapMemoryBarrier(m_CoherentMaps);
 
-    if(!m_MarkedActive)
-    {
-      m_MarkedActive = true;
+    if(Atomic::CmpExch32(&m_MarkedActive, 0, 1) == 0)
       RenderDoc::Inst().AddActiveDriver(GetDriverType(), false);
-    }
   }
 
   std::vector<FrameDescription> m_CapturedFrames;
@@ -467,6 +463,24 @@ private:
 
   std::map<void *, ContextData> m_ContextData;
 
+  struct ContextTLSData
+  {
+    ContextTLSData() : ctxPair({NULL, NULL}), ctxRecord(NULL), ctxData(NULL) {}
+    ContextTLSData(ContextPair p, GLResourceRecord *r, ContextData *d)
+        : ctxPair(p), ctxRecord(r), ctxData(d)
+    {
+    }
+    ContextPair ctxPair;
+    GLResourceRecord *ctxRecord;
+    // the entry in m_ContextData for ctxPair.ctx, cached so that fetching it on every call doesn't
+    // need a lookup in the map of all contexts.
+    ContextData *ctxData;
+  };
+
+  ContextTLSData m_EmptyTLSData;
+  uint64_t m_CurCtxDataTLS;
+  std::vector<ContextTLSData *> m_CtxDataVector;
+
   ContextData &GetCtxData();
   GLuint GetUniformProgram();
 
@@ -539,7 +553,7 @@ public:
   GLResourceManager *GetResourceManager() { return m_ResourceManager; }
   CaptureState GetState() { return m_State; }
   GLReplay *GetReplay() { return &m_Replay; }
-  WriteSerialiser &GetSerialiser() { return m_ScratchSerialiser; }
+  WriteSerialiser &GetThreadSerialiser();
   void SetDriverType(RDCDriver type) { m_DriverType = type; }
   bool isGLESMode() { return m_DriverType == RDCDriver::OpenGLES; }
   RDCDriver GetDriverType() { return m_DriverType; }
@@ -633,7 +647,16 @@ public:
     // pre-calculated bindpoint mapping for SPIR-V shaders. NOT valid for normal GLSL shaders
     ShaderBindpointMapping mapping;
 
-    void ProcessCompilation(WrappedOpenGL &drv, ResourceId id, GLuint realShader);
+    // set while the shader's compile has been issued on load but not yet processed, and when
+    // ProcessCompilation was asked to leave the SPIR-V compile for later
+    bool compilePending = false;
+    bool spirvPending = false;
+
+    void ProcessCompilation(WrappedOpenGL &drv, ResourceId id, GLuint realShader,
+                            bool deferSPIRV = false);
+    // compiles the sources to SPIR-V for disassembly. This only touches this shader's data and
+    // glslang, so different shaders can be processed on different threads at once.
+    void CompileSPIRV();
     void ProcessSPIRVCompilation(WrappedOpenGL &drv, ResourceId id, GLuint realShader,
                                  const GLchar *pEntryPoint, GLuint numSpecializationConstants,
                                  const GLuint *pConstantIndex, const GLuint *pConstantValue);
@@ -683,6 +706,13 @@ public:
   std::map<ResourceId, ProgramData> m_Programs;
   std::map<ResourceId, PipelineData> m_Pipelines;
 
+  // shaders whose compile was issued while loading but whose status and reflection haven't been
+  // fetched yet. Leaving them until something needs the results lets the driver compile them in
+  // parallel, and the SPIR-V work for all of them can then go to worker threads.
+  std::vector<rdcpair<ResourceId, GLuint>> m_PendingShaderCompiles;
+
+  void FlushPendingShaderCompiles();
+
   void FillReflectionArray(ResourceId program, PerStageReflections &stages)
   {
     ProgramData &progdata = m_Programs[program];
@@ -62,6 +62,61 @@ public:
   bool enabled = false;
 } glhook;
 
+// Most hooks take glLock exclusively. These are called very frequently from upload/streaming
+// threads and while background capturing they only modify their own context's state, records that
+// they lock, or sharded tracking. Global maps like the resource ID lookups are only read, and their
+// writers all take the lock exclusively, so these can run concurrently on different threads.
+// Anything that creates or deletes objects, or serialises into shared records without locking
+// them, must stay exclusive.
+static bool IsSharedLockGLCall(GLChunk chunk)
+{
+  switch(chunk)
+  {
+    case GLChunk::glActiveTexture:
+    case GLChunk::glBindBuffer:
+    case GLChunk::glBindTexture:
+    case GLChunk::glBufferSubData:
+    case GLChunk::glNamedBufferSubData:
+    case GLChunk::glNamedBufferSubDataEXT:
+    case GLChunk::glTexSubImage2D:
+    case GLChunk::glTextureSubImage2D:
+    case GLChunk::glTextureSubImage2DEXT:
+    case GLChunk::glFlush: return true;
+    default: break;
+  }
+
+  return false;
+}
+
+struct ScopedGLCallLock
+{
+  ScopedGLCallLock(bool sharedCall)
+  {
+    if(sharedCall && glhook.driver)
+    {
+      shared = glLock.LockShared();
+
+      // the capture state only changes with the lock held exclusively, so it can't change until
+      // we release it. While actively capturing everything must be serialised in order.
+      if(!shared || IsBackgroundCapturing(glhook.driver->GetState()))
+        return;
+
+      glLock.UnlockShared();
+      shared = false;
+    }
+
+    glLock.Lock();
+  }
+  ~ScopedGLCallLock()
+  {
+    if(shared)
+      glLock.UnlockShared();
+    else
+      glLock.Unlock();
+  }
+  bool shared = false;
+};
+
 #if ENABLED(RDOC_DEVEL)
 
 struct ScopedPrinter
@@ -79,23 +134,23 @@ struct ScopedPrinter
     depth--;
   }
   const char *func = NULL;
-  static int depth;
+  static thread_local int depth;
 };
 
-int ScopedPrinter::depth = 0;
+thread_local int ScopedPrinter::depth = 0;
 
 // This checks that we're not infinite looping by calling our own hooks from ourselves. Mostly
 // useful on android where you can only debug by printf and the stack dumps are often corrupted when
 // the callstack overflows.
-#define SCOPED_GLCALL(funcname)    \
-  SCOPED_LOCK(glLock);             \
-  gl_CurChunk = GLChunk::funcname; \
+#define SCOPED_GLCALL(funcname)                                                           \
+  ScopedGLCallLock CONCAT(scopedglcall, __LINE__)(IsSharedLockGLCall(GLChunk::funcname)); \
+  gl_CurChunk = GLChunk::funcname;                                                        \
   ScopedPrinter CONCAT(scopedprint, __LINE__)(STRINGIZE(funcname));
 
 #else
 
-#define SCOPED_GLCALL(funcname) \
-  SCOPED_LOCK(glLock);          \
+#define SCOPED_GLCALL(funcname)                                                           \
+  ScopedGLCallLock CONCAT(scopedglcall, __LINE__)(IsSharedLockGLCall(GLChunk::funcname)); \
   gl_CurChunk = GLChunk::funcname;
 
 #endif
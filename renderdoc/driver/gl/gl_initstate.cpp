@@ -167,6 +167,30 @@ void DoSerialise(SerialiserType &ser, TextureStateInitialData &el)
   SERIALISE_MEMBER(texBufSize);
 }
 
+// the most texture data we'll have in flight in readback buffers at once. Textures past this are
+// read back synchronously when serialised.
+static const uint64_t MaxReadbackBytesInFlight = 256 * 1024 * 1024;
+// the most idle readback buffer memory we keep around per share group, for the next capture
+static const uint64_t MaxReadbackBytesPooled = 64 * 1024 * 1024;
+
+// the size of one mip (and for cubemaps, one face) of a texture's initial contents
+static uint32_t GetInitialSubresourceSize(const TextureStateInitialData &state, int mip)
+{
+  uint32_t w = RDCMAX(state.width >> mip, 1U);
+  uint32_t h = RDCMAX(state.height >> mip, 1U);
+  uint32_t d = RDCMAX(state.depth >> mip, 1U);
+
+  if(state.type == eGL_TEXTURE_CUBE_MAP_ARRAY || state.type == eGL_TEXTURE_1D_ARRAY ||
+     state.type == eGL_TEXTURE_2D_ARRAY)
+    d = state.depth;
+
+  if(IsCompressedFormat(state.internalformat))
+    return (uint32_t)GetCompressedByteSize(w, h, d, state.internalformat);
+
+  return (uint32_t)GetByteSize(w, h, d, GetBaseFormat(state.internalformat),
+                               GetDataType(state.internalformat));
+}
+
 void WrappedOpenGL::TextureData::GetCompressedImageDataGLES(int mip, GLenum target, size_t size,
                                                             byte *buf)
 {
@@ -231,7 +255,7 @@ void GLResourceManager::ContextPrepare_InitialState(GLResource res)
   {
     WriteSerialiser ser(new StreamWriter(4 * 1024), Ownership::Stream);
 
-    ser.SetChunkMetadataRecording(m_Driver->GetSerialiser().GetChunkMetadataRecording());
+    ser.SetChunkMetadataRecording(m_Driver->GetThreadSerialiser().GetChunkMetadataRecording());
 
     SCOPED_SERIALISE_CHUNK(SystemChunk::InitialContents);
 
@@ -1000,6 +1024,10 @@ void GLResourceManager::PrepareTextureInitialContents(ResourceId liveid, Resourc
         GL.glTextureParameterivEXT(res.name, details.curType, eGL_TEXTURE_MAG_FILTER,
                                    (GLint *)&state.magFilter);
       }
+
+      // start reading the copy back now, so it's ready by the time we serialise it
+      if(IsCaptureMode(m_State))
+        QueueTextureReadback(origid, tex, state);
     }
 
     initContents.resource = GLResource(res.ContextShareGroup, eResTexture, tex);
@@ -1022,13 +1050,187 @@ void GLResourceManager::PrepareTextureInitialContents(ResourceId liveid, Resourc
   SetInitialContents(origid, initContents);
 }
 
+void GLResourceManager::QueueTextureReadback(ResourceId id, GLuint tex,
+                                             const TextureStateInitialData &state)
+{
+  // on GLES compressed data can't be read back from the GPU, and multisampled textures aren't
+  // serialised. Without fences we'd just stall when mapping, so we may as well read directly.
+  if(IsGLES || state.samples > 1 || !GL.glFenceSync || !GL.glClientWaitSync)
+    return;
+
+  // a resource could be prepared twice, e.g. if it's in a different share group to the one that
+  // started the capture. Only the newest readback is valid
+  auto it = m_TextureReadbacks.find(id);
+  if(it != m_TextureReadbacks.end())
+  {
+    m_ReadbackBytesInFlight -= it->second.size;
+    ReleaseReadbackBuffer(it->second);
+    m_TextureReadbacks.erase(it);
+  }
+
+  GLenum targets[] = {
+      eGL_TEXTURE_CUBE_MAP_POSITIVE_X, eGL_TEXTURE_CUBE_MAP_NEGATIVE_X,
+      eGL_TEXTURE_CUBE_MAP_POSITIVE_Y, eGL_TEXTURE_CUBE_MAP_NEGATIVE_Y,
+      eGL_TEXTURE_CUBE_MAP_POSITIVE_Z, eGL_TEXTURE_CUBE_MAP_NEGATIVE_Z,
+  };
+
+  int targetcount = ARRAY_COUNT(targets);
+
+  if(state.type != eGL_TEXTURE_CUBE_MAP)
+  {
+    targets[0] = state.type;
+    targetcount = 1;
+  }
+
+  uint64_t size = 0;
+  for(int i = 0; i < state.mips; i++)
+    size += GetInitialSubresourceSize(state, i) * targetcount;
+
+  if(size == 0 || m_ReadbackBytesInFlight + size > MaxReadbackBytesInFlight)
+    return;
+
+  GLuint prevPack = 0, prevTex = 0;
+  GL.glGetIntegerv(eGL_PIXEL_PACK_BUFFER_BINDING, (GLint *)&prevPack);
+  GL.glGetIntegerv(TextureBinding(state.type), (GLint *)&prevTex);
+
+  PixelPackState pack;
+  pack.Fetch(false);
+  ResetPixelPackState(false, 1);
+
+  TextureReadback readback = AcquireReadbackBuffer(size);
+
+  GL.glBindBuffer(eGL_PIXEL_PACK_BUFFER, readback.buffer.name);
+  GL.glBindTexture(state.type, tex);
+
+  bool isCompressed = IsCompressedFormat(state.internalformat);
+  GLenum fmt = GetBaseFormat(state.internalformat);
+  GLenum type = GetDataType(state.internalformat);
+
+  // with a pixel pack buffer bound these only queue the copy, the 'pointer' is an offset into the
+  // buffer. Subresources are packed in the same order they're serialised
+  uint64_t offset = 0;
+  for(int i = 0; i < state.mips; i++)
+  {
+    uint32_t subSize = GetInitialSubresourceSize(state, i);
+
+    for(int trg = 0; trg < targetcount; trg++)
+    {
+      void *dst = (void *)(uintptr_t)offset;
+
+      if(isCompressed)
+        GL.glGetCompressedTextureImageEXT(tex, targets[trg], i, dst);
+      else
+        GL.glGetTexImage(targets[trg], i, fmt, type, dst);
+
+      offset += subSize;
+    }
+  }
+
+  readback.fence = GL.glFenceSync(eGL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  GL.glBindTexture(state.type, prevTex);
+  GL.glBindBuffer(eGL_PIXEL_PACK_BUFFER, prevPack);
+  pack.Apply(false);
+
+  m_ReadbackBytesInFlight += readback.size;
+  m_TextureReadbacks[id] = readback;
+}
+
+GLResourceManager::TextureReadback GLResourceManager::AcquireReadbackBuffer(uint64_t size)
+{
+  ContextPair &ctx = m_Driver->GetCtx();
+
+  // use the smallest pooled buffer from this share group that's big enough
+  auto best = m_ReadbackPool.end();
+  for(auto it = m_ReadbackPool.begin(); it != m_ReadbackPool.end(); ++it)
+  {
+    if(it->buffer.ContextShareGroup == ctx.shareGroup && it->size >= size &&
+       (best == m_ReadbackPool.end() || it->size < best->size))
+      best = it;
+  }
+
+  TextureReadback ret;
+
+  if(best != m_ReadbackPool.end())
+  {
+    ret = *best;
+    m_ReadbackPool.erase(best);
+
+    if(ret.fence)
+      GL.glDeleteSync(ret.fence);
+    ret.fence = NULL;
+  }
+  else
+  {
+    GLuint buf = 0;
+    GL.glGenBuffers(1, &buf);
+    GL.glBindBuffer(eGL_PIXEL_PACK_BUFFER, buf);
+    GL.glNamedBufferDataEXT(buf, (GLsizeiptr)size, NULL, eGL_STREAM_READ);
+
+    ret.buffer = BufferRes(ctx, buf);
+    ret.size = size;
+  }
+
+  TrimReadbackPool();
+
+  return ret;
+}
+
+void GLResourceManager::ReleaseReadbackBuffer(const TextureReadback &readback)
+{
+  m_ReadbackPool.push_back(readback);
+}
+
+void GLResourceManager::TrimReadbackPool()
+{
+  ContextPair &ctx = m_Driver->GetCtx();
+
+  // we can only delete buffers and fences from the current share group, others are trimmed when
+  // they're next used
+  uint64_t pooled = 0;
+  for(auto it = m_ReadbackPool.begin(); it != m_ReadbackPool.end();)
+  {
+    if(it->buffer.ContextShareGroup != ctx.shareGroup)
+    {
+      ++it;
+      continue;
+    }
+
+    if(pooled + it->size <= MaxReadbackBytesPooled)
+    {
+      pooled += it->size;
+      ++it;
+      continue;
+    }
+
+    if(it->fence)
+      GL.glDeleteSync(it->fence);
+    GL.glDeleteBuffers(1, &it->buffer.name);
+    it = m_ReadbackPool.erase(it);
+  }
+}
+
+void GLResourceManager::ReleaseTextureReadbacks()
+{
+  for(auto it = m_TextureReadbacks.begin(); it != m_TextureReadbacks.end(); ++it)
+    ReleaseReadbackBuffer(it->second);
+
+  m_TextureReadbacks.clear();
+  m_ReadbackBytesInFlight = 0;
+
+  TrimReadbackPool();
+}
+
 void GLResourceManager::Force_ReferenceViews()
 {
   // don't need to force anything if we're already including all resources
   if(RenderDoc::Inst().GetCaptureOptions().refAllResources)
     return;
 
-  for(auto recordit = m_ResourceRecords.begin(); recordit != m_ResourceRecords.end(); ++recordit)
+  std::vector<std::pair<ResourceId, GLResourceRecord *>> records;
+  m_ResourceRecords.GetAll(records);
+
+  for(auto recordit = records.begin(); recordit != records.end(); ++recordit)
   {
     GLResourceRecord *record = recordit->second;
 
@@ -1037,14 +1239,14 @@ void GLResourceManager::Force_ReferenceViews()
     if(record && !record->viewTextures.empty())
     {
       // if this data resource was referenced already, just skip
-      if(m_FrameReferencedResources.find(record->GetResourceID()) != m_FrameReferencedResources.end())
+      if(m_FrameReferencedResources.Contains(record->GetResourceID()))
         continue;
 
       // see if any of our viewers were referenced
       for(auto it = record->viewTextures.begin(); it != record->viewTextures.end(); ++it)
       {
         // if so, return true to force our inclusion, for the benefit of the view
-        if(m_FrameReferencedResources.find(*it) != m_FrameReferencedResources.end())
+        if(m_FrameReferencedResources.Contains(*it))
         {
           RDCDEBUG("Forcing inclusion of %llu for %llu", record->GetResourceID(), *it);
           MarkResourceFrameReferenced(record->GetResourceID(), eFrameRef_ReadBeforeWrite);
@@ -1632,6 +1834,36 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
           // to avoid repeated new/free.
           byte *scratchBuf = AllocAlignedBuffer(size);
 
+          // on write, if the contents were read back when they were prepared, serialise straight
+          // from the readback buffer
+          TextureReadback readback;
+          byte *readbackData = NULL;
+
+          if(ser.IsWriting())
+          {
+            auto it = m_TextureReadbacks.find(id);
+            if(it != m_TextureReadbacks.end())
+            {
+              readback = it->second;
+              m_ReadbackBytesInFlight -= readback.size;
+              m_TextureReadbacks.erase(it);
+
+              GLenum status = eGL_TIMEOUT_EXPIRED;
+              while(status == eGL_TIMEOUT_EXPIRED)
+                status = GL.glClientWaitSync(readback.fence, eGL_SYNC_FLUSH_COMMANDS_BIT,
+                                             1000 * 1000 * 1000);
+
+              if(status != eGL_WAIT_FAILED)
+                readbackData = (byte *)GL.glMapNamedBufferRangeEXT(
+                    readback.buffer.name, 0, (GLsizeiptr)readback.size, eGL_MAP_READ_BIT);
+
+              if(!readbackData)
+                RDCERR("Couldn't map texture readback, reading back synchronously");
+            }
+          }
+
+          uint64_t readbackOffset = 0;
+
           // loop over all the available mips
           for(int i = 0; i < TextureState.mips; i++)
           {
@@ -1644,16 +1876,20 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
               d = TextureState.depth;
 
             // calculate the actual byte size of this mip
-            if(isCompressed)
-              size = (uint32_t)GetCompressedByteSize(w, h, d, TextureState.internalformat);
-            else
-              size = (uint32_t)GetByteSize(w, h, d, fmt, type);
+            size = GetInitialSubresourceSize(TextureState, i);
 
             // loop over the number of targets (this will only ever be >1 for cubemaps)
             for(int trg = 0; trg < targetcount; trg++)
             {
+              byte *contents = scratchBuf;
+
               // when writing, fetch the source data out of the texture
-              if(ser.IsWriting())
+              if(readbackData)
+              {
+                contents = readbackData + readbackOffset;
+                readbackOffset += size;
+              }
+              else if(ser.IsWriting())
               {
                 if(isCompressed)
                 {
@@ -1670,7 +1906,7 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
               }
 
               // serialise without allocating memory as we already have our scratch buf sized.
-              ser.Serialise("SubresourceContents"_lit, scratchBuf, size, SerialiserFlags::NoFlags);
+              ser.Serialise("SubresourceContents"_lit, contents, size, SerialiserFlags::NoFlags);
 
               // on replay, restore the data into the initial contents texture
               if(IsReplayingAndReading() && !ser.IsErrored())
@@ -1716,6 +1952,13 @@ bool GLResourceManager::Serialise_InitialState(SerialiserType &ser, ResourceId i
 
           // free our scratch buffer
           FreeAlignedBuffer(scratchBuf);
+
+          if(readback.buffer.name)
+          {
+            if(readbackData)
+              GL.glUnmapNamedBufferEXT(readback.buffer.name);
+            ReleaseReadbackBuffer(readback);
+          }
         }
 
         // restore the previous texture binding
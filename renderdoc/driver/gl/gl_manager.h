@@ -122,6 +122,15 @@ public:
     }
     RDCDEBUG("Removed %zu/%zu resources belonging to context/sharegroup %p", count,
              m_CurrentResourceIds.size(), context);
+
+    // pooled readback buffers are destroyed along with the share group
+    for(auto it = m_ReadbackPool.begin(); it != m_ReadbackPool.end();)
+    {
+      if(it->buffer.ContextShareGroup == context)
+        it = m_ReadbackPool.erase(it);
+      else
+        ++it;
+    }
   }
 
   inline void RemoveResourceRecord(ResourceId id)
@@ -256,6 +265,8 @@ public:
                               const GLInitialContents *initial);
 
   void ContextPrepare_InitialState(GLResource res);
+  // return any texture readbacks that weren't serialised to the pool, at the end of a capture
+  void ReleaseTextureReadbacks();
   bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, GLResourceRecord *record,
                               const GLInitialContents *initial)
   {
@@ -267,6 +278,7 @@ public:
 private:
   bool ResourceTypeRelease(GLResource res);
   bool Prepare_InitialState(GLResource res);
+  std::string GetInitialStateTypeName(GLResource res) { return ToStr(res.Namespace); }
   uint64_t GetSize_InitialState(ResourceId resid, const GLInitialContents &initial);
 
   void CreateTextureImage(GLuint tex, GLenum internalFormat, GLenum internalFormatHint,
@@ -274,6 +286,25 @@ private:
                           GLint samples, int mips);
   void PrepareTextureInitialContents(ResourceId liveid, ResourceId origid, GLResource res);
 
+  // Texture initial contents are read back into a pixel pack buffer when they're prepared, with a
+  // fence after, so the copy to CPU memory happens while the frame is running. Serialising only
+  // needs to wait on the fence and map the buffer.
+  struct TextureReadback
+  {
+    GLResource buffer;
+    uint64_t size = 0;
+    GLsync fence = NULL;
+  };
+
+  void QueueTextureReadback(ResourceId id, GLuint tex, const TextureStateInitialData &state);
+  TextureReadback AcquireReadbackBuffer(uint64_t size);
+  void ReleaseReadbackBuffer(const TextureReadback &readback);
+  void TrimReadbackPool();
+
+  std::map<ResourceId, TextureReadback> m_TextureReadbacks;
+  uint64_t m_ReadbackBytesInFlight = 0;
+  std::vector<TextureReadback> m_ReadbackPool;
+
   void Create_InitialState(ResourceId id, GLResource live, bool hasData);
   void Apply_InitialState(GLResource live, const GLInitialContents &initial);
 
@@ -136,6 +136,9 @@ void GLReplay::ClearPostVSCache()
   }
 
   m_PostVSData.clear();
+
+  // post-transform buffers can be reused, so any BVH built from them is stale
+  m_PickCache.Clear();
 }
 
 void GLReplay::InitPostVSBuffers(uint32_t eventId)
@@ -185,6 +185,11 @@ rdcarray<GPUDevice> GLReplay::GetAvailableGPUs()
   return {};
 }
 
+InitialStateRestoreStats GLReplay::GetInitialStateRestoreStats()
+{
+  return m_pDriver->GetResourceManager()->GetInitialStateRestoreStats();
+}
+
 APIProperties GLReplay::GetAPIProperties()
 {
   APIProperties ret = m_pDriver->APIProps;
@@ -3476,6 +3481,7 @@ ReplayStatus CreateReplayDevice(RDCDriver rdcdriver, RDCFile *rdc, const ReplayO
   gldriver->SetDriverType(rdcdriver);
 
   GL.DriverForEmulation(gldriver);
+  GL.ShadowReplayState(gldriver);
 
   RDCLOG("Created %s replay device.", ToStr(rdcdriver).c_str());
 
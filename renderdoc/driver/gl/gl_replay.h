@@ -92,6 +92,7 @@ public:
   void SetDriver(WrappedOpenGL *d) { m_pDriver = d; }
   DriverInformation GetDriverInfo() { return m_DriverInfo; }
   rdcarray<GPUDevice> GetAvailableGPUs();
+  InitialStateRestoreStats GetInitialStateRestoreStats();
   APIProperties GetAPIProperties();
 
   ResourceDescription &GetResourceDesc(ResourceId id);
@@ -393,6 +394,7 @@ private:
   bool m_Degraded;
 
   HighlightCache m_HighlightCache;
+  MeshPickCache m_PickCache;
 
   // eventId -> data
   std::map<uint32_t, GLPostVSData> m_PostVSData;
@@ -309,11 +309,3 @@ private:
   byte *ShadowPtr[2];
   size_t ShadowSize;
 };
-
-struct GLContextTLSData
-{
-  GLContextTLSData() : ctxPair({NULL, NULL}), ctxRecord(NULL) {}
-  GLContextTLSData(ContextPair p, GLResourceRecord *r) : ctxPair(p), ctxRecord(r) {}
-  ContextPair ctxPair;
-  GLResourceRecord *ctxRecord;
-};
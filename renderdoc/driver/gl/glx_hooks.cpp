@@ -128,7 +128,7 @@ HOOK_EXPORT GLXContext glXCreateContext_renderdoc_hooked(Display *dpy, XVisualIn
   data.cfg = vis;
 
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
     glxhook.driver.CreateContext(data, shareList, init, false, false);
   }
 
@@ -148,7 +148,7 @@ HOOK_EXPORT void glXDestroyContext_renderdoc_hooked(Display *dpy, GLXContext ctx
   EnsureRealLibraryLoaded();
 
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
     glxhook.driver.DeleteContext(ctx);
     glxhook.contexts.erase(ctx);
   }
@@ -273,7 +273,7 @@ HOOK_EXPORT GLXContext glXCreateContextAttribsARB_renderdoc_hooked(Display *dpy,
   data.cfg = vis;
 
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
     glxhook.driver.CreateContext(data, shareList, init, core, true);
   }
 
@@ -298,7 +298,7 @@ HOOK_EXPORT Bool glXMakeCurrent_renderdoc_hooked(Display *dpy, GLXDrawable drawa
 
   if(ret)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     SetDriverForHooks(&glxhook.driver);
 
@@ -368,7 +368,7 @@ HOOK_EXPORT Bool glXMakeContextCurrent_renderdoc_hooked(Display *dpy, GLXDrawabl
 
   if(ret)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     SetDriverForHooks(&glxhook.driver);
 
@@ -432,7 +432,7 @@ HOOK_EXPORT void glXSwapBuffers_renderdoc_hooked(Display *dpy, GLXDrawable drawa
 
   EnsureRealLibraryLoaded();
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   {
     GLWindowingData data;
@@ -180,7 +180,7 @@ void WGLHook::ProcessSwapBuffers(HDC dc)
     RefreshWindowParameters(data);
 
     {
-      SCOPED_LOCK(glLock);
+      SCOPED_GLLOCK();
       driver.SwapBuffers(WindowingSystem::Win32, w);
     }
 
@@ -190,7 +190,7 @@ void WGLHook::ProcessSwapBuffers(HDC dc)
 
 static HGLRC WINAPI wglCreateContext_hooked(HDC dc)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   if(wglhook.createRecurse || wglhook.eglDisabled)
     return WGL.wglCreateContext(dc);
@@ -224,11 +224,11 @@ static HGLRC WINAPI wglCreateContext_hooked(HDC dc)
 
 static BOOL WINAPI wglDeleteContext_hooked(HGLRC rc)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   if(wglhook.haveContextCreation && !wglhook.eglDisabled)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
     wglhook.driver.DeleteContext(rc);
     wglhook.contexts.erase(rc);
   }
@@ -240,7 +240,7 @@ static BOOL WINAPI wglDeleteContext_hooked(HGLRC rc)
 
 static HGLRC WINAPI wglCreateLayerContext_hooked(HDC dc, int iLayerPlane)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   if(wglhook.createRecurse || wglhook.eglDisabled)
     return WGL.wglCreateLayerContext(dc, iLayerPlane);
@@ -277,7 +277,7 @@ static HGLRC WINAPI wglCreateLayerContext_hooked(HDC dc, int iLayerPlane)
 static HGLRC WINAPI wglCreateContextAttribsARB_hooked(HDC dc, HGLRC hShareContext,
                                                       const int *attribList)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   // don't recurse
   if(wglhook.createRecurse || wglhook.eglDisabled)
@@ -384,7 +384,7 @@ static HGLRC WINAPI wglCreateContextAttribsARB_hooked(HDC dc, HGLRC hShareContex
 
 static BOOL WINAPI wglShareLists_hooked(HGLRC oldContext, HGLRC newContext)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   bool ret = WGL.wglShareLists(oldContext, newContext) == TRUE;
 
@@ -392,7 +392,7 @@ static BOOL WINAPI wglShareLists_hooked(HGLRC oldContext, HGLRC newContext)
 
   if(ret && !wglhook.eglDisabled)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     ret &= wglhook.driver.ForceSharedObjects(oldContext, newContext);
   }
@@ -404,7 +404,7 @@ static BOOL WINAPI wglShareLists_hooked(HGLRC oldContext, HGLRC newContext)
 
 static BOOL WINAPI wglMakeCurrent_hooked(HDC dc, HGLRC rc)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   BOOL ret = WGL.wglMakeCurrent(dc, rc);
 
@@ -412,7 +412,7 @@ static BOOL WINAPI wglMakeCurrent_hooked(HDC dc, HGLRC rc)
 
   if(ret && !wglhook.eglDisabled)
   {
-    SCOPED_LOCK(glLock);
+    SCOPED_GLLOCK();
 
     SetDriverForHooks(&wglhook.driver);
 
@@ -446,7 +446,7 @@ static BOOL WINAPI wglMakeCurrent_hooked(HDC dc, HGLRC rc)
 
 static BOOL WINAPI SwapBuffers_hooked(HDC dc)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   wglhook.ProcessSwapBuffers(dc);
 
@@ -459,7 +459,7 @@ static BOOL WINAPI SwapBuffers_hooked(HDC dc)
 
 static BOOL WINAPI wglSwapBuffers_hooked(HDC dc)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   wglhook.ProcessSwapBuffers(dc);
 
@@ -472,7 +472,7 @@ static BOOL WINAPI wglSwapBuffers_hooked(HDC dc)
 
 static BOOL WINAPI wglSwapLayerBuffers_hooked(HDC dc, UINT planes)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   wglhook.ProcessSwapBuffers(dc);
 
@@ -485,7 +485,7 @@ static BOOL WINAPI wglSwapLayerBuffers_hooked(HDC dc, UINT planes)
 
 static BOOL WINAPI wglSwapMultipleBuffers_hooked(UINT numSwaps, CONST WGLSWAP *pSwaps)
 {
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   for(UINT i = 0; pSwaps && i < numSwaps; i++)
     wglhook.ProcessSwapBuffers(pSwaps[i].hdc);
@@ -545,7 +545,7 @@ static PROC WINAPI wglGetProcAddress_hooked(const char *func)
     return WGL.wglGetProcAddress(func);
   }
 
-  SCOPED_LOCK(glLock);
+  SCOPED_GLLOCK();
 
   PROC realFunc = NULL;
   {
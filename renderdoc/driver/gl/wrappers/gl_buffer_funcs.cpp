@@ -312,12 +312,13 @@ void WrappedOpenGL::glBindBuffer(GLenum target, GLuint buffer)
       return;
     }
 
-    // it's legal to re-type buffers, generate another BindBuffer chunk to rename
+    // it's legal to re-type buffers, generate another BindBuffer chunk to rename. Another thread
+    // could be binding the same buffer, so check and re-type with the record locked.
+    r->LockChunks();
     if(r->datatype != target)
     {
       Chunk *chunk = NULL;
 
-      r->LockChunks();
       for(;;)
       {
         Chunk *end = r->GetLastChunk();
@@ -334,7 +335,6 @@ void WrappedOpenGL::glBindBuffer(GLenum target, GLuint buffer)
 
         break;
       }
-      r->UnlockChunks();
 
       r->datatype = target;
 
@@ -348,6 +348,7 @@ void WrappedOpenGL::glBindBuffer(GLenum target, GLuint buffer)
 
       r->AddChunk(chunk);
     }
+    r->UnlockChunks();
 
     // element array buffer binding is vertex array record state, record there (if we've not just
     // stopped)
@@ -938,8 +939,7 @@ void WrappedOpenGL::glNamedBufferSubDataEXT(GLuint buffer, GLintptr offset, GLsi
     if(record == NULL)
       return;
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -957,14 +957,18 @@ void WrappedOpenGL::glNamedBufferSubDataEXT(GLuint buffer, GLintptr offset, GLsi
     }
     else
     {
+      // this can run concurrently on other threads uploading to the same buffer, see
+      // IsSharedLockGLCall
+      record->LockChunks();
       record->AddChunk(chunk);
       record->UpdateCount++;
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
+      record->UnlockChunks();
     }
   }
 }
@@ -999,8 +1003,7 @@ void WrappedOpenGL::glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr s
 
     GLResource res = record->Resource;
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -1018,14 +1021,18 @@ void WrappedOpenGL::glBufferSubData(GLenum target, GLintptr offset, GLsizeiptr s
     }
     else
     {
+      // this can run concurrently on other threads uploading to the same buffer, see
+      // IsSharedLockGLCall
+      record->LockChunks();
       record->AddChunk(chunk);
       record->UpdateCount++;
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
+      record->UnlockChunks();
     }
   }
 }
@@ -1081,14 +1088,14 @@ void WrappedOpenGL::glNamedCopyBufferSubDataEXT(GLuint readBuffer, GLuint writeB
         GetResourceManager()->GetResourceRecord(BufferRes(GetCtx(), writeBuffer));
     RDCASSERT(readrecord && writerecord);
 
-    if(m_HighTrafficResources.find(writerecord->GetResourceID()) != m_HighTrafficResources.end() &&
+    if(m_HighTrafficResources.Contains(writerecord->GetResourceID()) &&
        IsBackgroundCapturing(m_State))
       return;
 
     if(GetResourceManager()->IsResourceDirty(readrecord->GetResourceID()) &&
        IsBackgroundCapturing(m_State))
     {
-      m_HighTrafficResources.insert(writerecord->GetResourceID());
+      m_HighTrafficResources.Set(writerecord->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(writerecord->GetResourceID());
       return;
     }
@@ -1115,7 +1122,7 @@ void WrappedOpenGL::glNamedCopyBufferSubDataEXT(GLuint readBuffer, GLuint writeB
 
       if(writerecord->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(writerecord->GetResourceID());
+        m_HighTrafficResources.Set(writerecord->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(writerecord->GetResourceID());
       }
     }
@@ -1150,14 +1157,14 @@ void WrappedOpenGL::glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, G
     GLResourceRecord *writerecord = GetCtxData().m_BufferRecord[BufferIdx(writeTarget)];
     RDCASSERT(readrecord && writerecord);
 
-    if(m_HighTrafficResources.find(writerecord->GetResourceID()) != m_HighTrafficResources.end() &&
+    if(m_HighTrafficResources.Contains(writerecord->GetResourceID()) &&
        IsBackgroundCapturing(m_State))
       return;
 
     if(GetResourceManager()->IsResourceDirty(readrecord->GetResourceID()) &&
        IsBackgroundCapturing(m_State))
     {
-      m_HighTrafficResources.insert(writerecord->GetResourceID());
+      m_HighTrafficResources.Set(writerecord->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(writerecord->GetResourceID());
       return;
     }
@@ -1184,7 +1191,7 @@ void WrappedOpenGL::glCopyBufferSubData(GLenum readTarget, GLenum writeTarget, G
 
       if(writerecord->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(writerecord->GetResourceID());
+        m_HighTrafficResources.Set(writerecord->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(writerecord->GetResourceID());
       }
     }
@@ -2059,7 +2066,7 @@ void *WrappedOpenGL::glMapNamedBufferRangeEXT(GLuint buffer, GLintptr offset, GL
 
     // first check if we've already given up on these buffers
     if(IsBackgroundCapturing(m_State) &&
-       m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end())
+       m_HighTrafficResources.Contains(record->GetResourceID()))
       directMap = true;
 
     if(!directMap && IsBackgroundCapturing(m_State) &&
@@ -2108,7 +2115,7 @@ void *WrappedOpenGL::glMapNamedBufferRangeEXT(GLuint buffer, GLintptr offset, GL
     // anything which is directly mapped for write becomes dirty/high traffic
     if(directMap && (access & GL_MAP_WRITE_BIT))
     {
-      m_HighTrafficResources.insert(record->GetResourceID());
+      m_HighTrafficResources.Set(record->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
     }
 
@@ -2194,7 +2201,7 @@ void *WrappedOpenGL::glMapNamedBufferRangeEXT(GLuint buffer, GLintptr offset, GL
       // mark as high-traffic if we update it often enough
       if(record->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
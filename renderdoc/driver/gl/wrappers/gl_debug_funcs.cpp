@@ -152,8 +152,9 @@ void WrappedOpenGL::glLabelObjectEXT(GLenum identifier, GLuint name, GLsizei len
   }
   else
   {
-    m_ScratchSerialiser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
-    m_ScratchSerialiser.ChunkMetadata().durationMicro = 0;
+    WriteSerialiser &ser = GetThreadSerialiser();
+    ser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
+    ser.ChunkMetadata().durationMicro = 0;
   }
 
   if(IsCaptureMode(m_State))
@@ -183,8 +184,9 @@ void WrappedOpenGL::glObjectLabel(GLenum identifier, GLuint name, GLsizei length
   }
   else
   {
-    m_ScratchSerialiser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
-    m_ScratchSerialiser.ChunkMetadata().durationMicro = 0;
+    WriteSerialiser &ser = GetThreadSerialiser();
+    ser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
+    ser.ChunkMetadata().durationMicro = 0;
   }
 
   if(IsCaptureMode(m_State))
@@ -214,8 +216,9 @@ void WrappedOpenGL::glObjectPtrLabel(const void *ptr, GLsizei length, const GLch
   }
   else
   {
-    m_ScratchSerialiser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
-    m_ScratchSerialiser.ChunkMetadata().durationMicro = 0;
+    WriteSerialiser &ser = GetThreadSerialiser();
+    ser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
+    ser.ChunkMetadata().durationMicro = 0;
   }
 
   if(IsCaptureMode(m_State))
@@ -314,8 +317,9 @@ void WrappedOpenGL::glDebugMessageInsert(GLenum source, GLenum type, GLuint id,
   }
   else
   {
-    m_ScratchSerialiser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
-    m_ScratchSerialiser.ChunkMetadata().durationMicro = 0;
+    WriteSerialiser &ser = GetThreadSerialiser();
+    ser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
+    ser.ChunkMetadata().durationMicro = 0;
   }
 
   HandleVRFrameMarkers(buf, length);
@@ -461,8 +465,9 @@ void WrappedOpenGL::glPushDebugGroup(GLenum source, GLuint id, GLsizei length, c
   }
   else
   {
-    m_ScratchSerialiser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
-    m_ScratchSerialiser.ChunkMetadata().durationMicro = 0;
+    WriteSerialiser &ser = GetThreadSerialiser();
+    ser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
+    ser.ChunkMetadata().durationMicro = 0;
   }
 
   if(IsActiveCapturing(m_State))
@@ -505,8 +510,9 @@ void WrappedOpenGL::glPopDebugGroup()
   }
   else
   {
-    m_ScratchSerialiser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
-    m_ScratchSerialiser.ChunkMetadata().durationMicro = 0;
+    WriteSerialiser &ser = GetThreadSerialiser();
+    ser.ChunkMetadata().timestampMicro = RenderDoc::Inst().GetMicrosecondTimestamp();
+    ser.ChunkMetadata().durationMicro = 0;
   }
 
   if(IsActiveCapturing(m_State))
@@ -194,8 +194,7 @@ void WrappedOpenGL::glNamedFramebufferTextureEXT(GLuint framebuffer, GLenum atta
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -209,7 +208,7 @@ void WrappedOpenGL::glNamedFramebufferTextureEXT(GLuint framebuffer, GLenum atta
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
       GetResourceManager()->MarkFBOReferenced(record->Resource, eFrameRef_ReadBeforeWrite);
@@ -248,8 +247,7 @@ void WrappedOpenGL::glFramebufferTexture(GLenum target, GLenum attachment, GLuin
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -268,7 +266,7 @@ void WrappedOpenGL::glFramebufferTexture(GLenum target, GLenum attachment, GLuin
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
@@ -331,8 +329,7 @@ void WrappedOpenGL::glNamedFramebufferTexture1DEXT(GLuint framebuffer, GLenum at
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -348,7 +345,7 @@ void WrappedOpenGL::glNamedFramebufferTexture1DEXT(GLuint framebuffer, GLenum at
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -387,8 +384,7 @@ void WrappedOpenGL::glFramebufferTexture1D(GLenum target, GLenum attachment, GLe
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -408,7 +404,7 @@ void WrappedOpenGL::glFramebufferTexture1D(GLenum target, GLenum attachment, GLe
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
@@ -471,8 +467,7 @@ void WrappedOpenGL::glNamedFramebufferTexture2DEXT(GLuint framebuffer, GLenum at
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -488,7 +483,7 @@ void WrappedOpenGL::glNamedFramebufferTexture2DEXT(GLuint framebuffer, GLenum at
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -527,8 +522,7 @@ void WrappedOpenGL::glFramebufferTexture2D(GLenum target, GLenum attachment, GLe
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -548,7 +542,7 @@ void WrappedOpenGL::glFramebufferTexture2D(GLenum target, GLenum attachment, GLe
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
@@ -635,8 +629,7 @@ void WrappedOpenGL::glFramebufferTexture2DMultisampleEXT(GLenum target, GLenum a
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -656,7 +649,7 @@ void WrappedOpenGL::glFramebufferTexture2DMultisampleEXT(GLenum target, GLenum a
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
@@ -723,8 +716,7 @@ void WrappedOpenGL::glNamedFramebufferTexture3DEXT(GLuint framebuffer, GLenum at
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -741,7 +733,7 @@ void WrappedOpenGL::glNamedFramebufferTexture3DEXT(GLuint framebuffer, GLenum at
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -781,8 +773,7 @@ void WrappedOpenGL::glFramebufferTexture3D(GLenum target, GLenum attachment, GLe
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -802,7 +793,7 @@ void WrappedOpenGL::glFramebufferTexture3D(GLenum target, GLenum attachment, GLe
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
@@ -862,8 +853,7 @@ void WrappedOpenGL::glNamedFramebufferRenderbufferEXT(GLuint framebuffer, GLenum
     GLResourceRecord *record =
         GetResourceManager()->GetResourceRecord(FramebufferRes(GetCtx(), framebuffer));
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -880,7 +870,7 @@ void WrappedOpenGL::glNamedFramebufferRenderbufferEXT(GLuint framebuffer, GLenum
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -915,8 +905,7 @@ void WrappedOpenGL::glFramebufferRenderbuffer(GLenum target, GLenum attachment,
         record = GetCtxData().m_ReadFramebufferRecord;
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -936,7 +925,7 @@ void WrappedOpenGL::glFramebufferRenderbuffer(GLenum target, GLenum attachment,
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
@@ -1000,8 +989,7 @@ void WrappedOpenGL::glNamedFramebufferTextureLayerEXT(GLuint framebuffer, GLenum
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -1017,7 +1005,7 @@ void WrappedOpenGL::glNamedFramebufferTextureLayerEXT(GLuint framebuffer, GLenum
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -1056,8 +1044,7 @@ void WrappedOpenGL::glFramebufferTextureLayer(GLenum target, GLenum attachment,
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -1077,7 +1064,7 @@ void WrappedOpenGL::glFramebufferTextureLayer(GLenum target, GLenum attachment,
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
@@ -1161,8 +1148,7 @@ void WrappedOpenGL::glFramebufferTextureMultiviewOVR(GLenum target, GLenum attac
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     // because there's no DSA variant of the OVR framebuffer functions we must ensure that while
@@ -1194,7 +1180,7 @@ void WrappedOpenGL::glFramebufferTextureMultiviewOVR(GLenum target, GLenum attac
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
@@ -1277,8 +1263,7 @@ void WrappedOpenGL::glFramebufferTextureMultisampleMultiviewOVR(GLenum target, G
       GetResourceManager()->MarkDirtyResource(TextureRes(GetCtx(), texture));
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     // because there's no DSA variant of the OVR framebuffer functions we must ensure that while
@@ -1310,7 +1295,7 @@ void WrappedOpenGL::glFramebufferTextureMultisampleMultiviewOVR(GLenum target, G
 
         if(record->UpdateCount > 10)
         {
-          m_HighTrafficResources.insert(record->GetResourceID());
+          m_HighTrafficResources.Set(record->GetResourceID(), true);
           GetResourceManager()->MarkDirtyResource(record->GetResourceID());
         }
       }
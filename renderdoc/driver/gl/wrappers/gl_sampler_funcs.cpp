@@ -275,8 +275,7 @@ void WrappedOpenGL::glSamplerParameteri(GLuint sampler, GLenum pname, GLint para
   {
     GLResourceRecord *record = GetResourceManager()->GetResourceRecord(SamplerRes(GetCtx(), sampler));
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -293,7 +292,7 @@ void WrappedOpenGL::glSamplerParameteri(GLuint sampler, GLenum pname, GLint para
 
       if(record->UpdateCount > 20)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -338,8 +337,7 @@ void WrappedOpenGL::glSamplerParameterf(GLuint sampler, GLenum pname, GLfloat pa
   {
     GLResourceRecord *record = GetResourceManager()->GetResourceRecord(SamplerRes(GetCtx(), sampler));
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -356,7 +354,7 @@ void WrappedOpenGL::glSamplerParameterf(GLuint sampler, GLenum pname, GLfloat pa
 
       if(record->UpdateCount > 20)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -402,8 +400,7 @@ void WrappedOpenGL::glSamplerParameteriv(GLuint sampler, GLenum pname, const GLi
   {
     GLResourceRecord *record = GetResourceManager()->GetResourceRecord(SamplerRes(GetCtx(), sampler));
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -420,7 +417,7 @@ void WrappedOpenGL::glSamplerParameteriv(GLuint sampler, GLenum pname, const GLi
 
       if(record->UpdateCount > 20)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -466,8 +463,7 @@ void WrappedOpenGL::glSamplerParameterfv(GLuint sampler, GLenum pname, const GLf
   {
     GLResourceRecord *record = GetResourceManager()->GetResourceRecord(SamplerRes(GetCtx(), sampler));
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -484,7 +480,7 @@ void WrappedOpenGL::glSamplerParameterfv(GLuint sampler, GLenum pname, const GLf
 
       if(record->UpdateCount > 20)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -530,8 +526,7 @@ void WrappedOpenGL::glSamplerParameterIiv(GLuint sampler, GLenum pname, const GL
   {
     GLResourceRecord *record = GetResourceManager()->GetResourceRecord(SamplerRes(GetCtx(), sampler));
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -548,7 +543,7 @@ void WrappedOpenGL::glSamplerParameterIiv(GLuint sampler, GLenum pname, const GL
 
       if(record->UpdateCount > 20)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -594,8 +589,7 @@ void WrappedOpenGL::glSamplerParameterIuiv(GLuint sampler, GLenum pname, const G
   {
     GLResourceRecord *record = GetResourceManager()->GetResourceRecord(SamplerRes(GetCtx(), sampler));
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -612,7 +606,7 @@ void WrappedOpenGL::glSamplerParameterIuiv(GLuint sampler, GLenum pname, const G
 
       if(record->UpdateCount > 20)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -83,7 +83,7 @@ void WrappedOpenGL::ShaderData::ProcessSPIRVCompilation(WrappedOpenGL &drv, Reso
 }
 
 void WrappedOpenGL::ShaderData::ProcessCompilation(WrappedOpenGL &drv, ResourceId id,
-                                                   GLuint realShader)
+                                                   GLuint realShader, bool deferSPIRV)
 {
   FixedFunctionVertexOutputs outputUsage = {};
   if(type == eGL_VERTEX_SHADER)
@@ -262,16 +262,10 @@ void WrappedOpenGL::ShaderData::ProcessCompilation(WrappedOpenGL &drv, ResourceI
 
       if(reflected)
       {
-        std::vector<uint32_t> spirvwords;
-
-        rdcspv::CompilationSettings settings(rdcspv::InputLanguage::OpenGLGLSL,
-                                             rdcspv::ShaderStage(ShaderIdx(type)));
-
-        std::string s = rdcspv::Compile(settings, sources, spirvwords);
-        if(!spirvwords.empty())
-          spirv.Parse(spirvwords);
+        if(deferSPIRV)
+          spirvPending = true;
         else
-          disassembly = "Disassembly to SPIR-V failed:\n\n" + s;
+          CompileSPIRV();
 
         reflection.resourceId = id;
 
@@ -287,6 +281,77 @@ void WrappedOpenGL::ShaderData::ProcessCompilation(WrappedOpenGL &drv, ResourceI
   }
 }
 
+void WrappedOpenGL::ShaderData::CompileSPIRV()
+{
+  spirvPending = false;
+
+  std::vector<uint32_t> spirvwords;
+
+  rdcspv::CompilationSettings settings(rdcspv::InputLanguage::OpenGLGLSL,
+                                       rdcspv::ShaderStage(ShaderIdx(type)));
+
+  std::string s = rdcspv::Compile(settings, sources, spirvwords);
+  if(!spirvwords.empty())
+    spirv.Parse(spirvwords);
+  else
+    disassembly = "Disassembly to SPIR-V failed:\n\n" + s;
+}
+
+void WrappedOpenGL::FlushPendingShaderCompiles()
+{
+  if(m_PendingShaderCompiles.empty())
+    return;
+
+  SCOPED_TIMER("Processing %u deferred shader compiles", (uint32_t)m_PendingShaderCompiles.size());
+
+  std::vector<rdcpair<ResourceId, GLuint>> pending;
+  pending.swap(m_PendingShaderCompiles);
+
+  std::vector<ShaderData *> spirvWork;
+
+  const bool pollCompletion =
+      HasExt[KHR_parallel_shader_compile] || HasExt[ARB_parallel_shader_compile];
+
+  // fetch the results in the order the driver finishes them, so one slow shader doesn't hold up
+  // processing the rest. Each pass handles at least one shader, if nothing else has finished by the
+  // end of a pass we block on the last one.
+  while(!pending.empty())
+  {
+    size_t remaining = 0;
+    bool processedAny = false;
+
+    for(size_t i = 0; i < pending.size(); i++)
+    {
+      GLint done = 1;
+      if(pollCompletion)
+        GL.glGetShaderiv(pending[i].second, eGL_COMPLETION_STATUS_KHR, &done);
+
+      if(!done && (processedAny || i + 1 < pending.size()))
+      {
+        pending[remaining++] = pending[i];
+        continue;
+      }
+
+      processedAny = true;
+
+      ShaderData &shad = m_Shaders[pending[i].first];
+
+      shad.compilePending = false;
+      shad.ProcessCompilation(*this, GetResourceManager()->GetOriginalID(pending[i].first),
+                              pending[i].second, true);
+
+      if(shad.spirvPending)
+        spirvWork.push_back(&shad);
+    }
+
+    pending.resize(remaining);
+  }
+
+  // glslang doesn't need a context, so the SPIR-V compiles for every shader can run at once
+  Threading::ParallelFor((uint32_t)spirvWork.size(),
+                         [&spirvWork](uint32_t i) { spirvWork[i]->CompileSPIRV(); });
+}
+
 #pragma region Shaders
 
 template <typename SerialiserType>
@@ -385,6 +450,10 @@ bool WrappedOpenGL::Serialise_glShaderSource(SerialiserType &ser, GLuint shaderH
 
     ResourceId liveId = GetResourceManager()->GetID(shader);
 
+    // a pending compile must be processed with the sources it was compiled from
+    if(m_Shaders[liveId].compilePending)
+      FlushPendingShaderCompiles();
+
     m_Shaders[liveId].sources = sources;
 
     GL.glShaderSource(shader.name, (GLsizei)sources.size(), strs.data(), NULL);
@@ -454,10 +523,22 @@ bool WrappedOpenGL::Serialise_glCompileShader(SerialiserType &ser, GLuint shader
   {
     ResourceId liveId = GetResourceManager()->GetID(shader);
 
+    // recompiling a shader that's still pending would lose the first compile's results
+    if(m_Shaders[liveId].compilePending)
+      FlushPendingShaderCompiles();
+
     GL.glCompileShader(shader.name);
 
-    m_Shaders[liveId].ProcessCompilation(*this, GetResourceManager()->GetOriginalID(liveId),
-                                         shader.name);
+    // while loading, issue the compile and come back for the results once they're needed. See
+    // FlushPendingShaderCompiles()
+    if(IsLoading(m_State))
+    {
+      m_Shaders[liveId].compilePending = true;
+      m_PendingShaderCompiles.push_back({liveId, shader.name});
+    }
+    else
+      m_Shaders[liveId].ProcessCompilation(*this, GetResourceManager()->GetOriginalID(liveId),
+                                           shader.name);
 
     AddResourceInitChunk(shader);
   }
@@ -830,6 +911,9 @@ bool WrappedOpenGL::Serialise_glLinkProgram(SerialiserType &ser, GLuint programH
 
     if(!HasExt[ARB_program_interface_query])
     {
+      // the glslang shaders are made when processing the compile
+      FlushPendingShaderCompiles();
+
       std::vector<glslang::TShader *> glslangShaders;
 
       for(ResourceId id : progDetails.stageShaders)
@@ -904,6 +988,9 @@ void WrappedOpenGL::glLinkProgram(GLuint program)
 
     if(!HasExt[ARB_program_interface_query])
     {
+      // the glslang shaders are made when processing the compile
+      FlushPendingShaderCompiles();
+
       std::vector<glslang::TShader *> glslangShaders;
 
       for(ResourceId id : progDetails.stageShaders)
@@ -1473,8 +1560,7 @@ void WrappedOpenGL::glUseProgramStages(GLuint pipeline, GLbitfield stages, GLuin
                                                         eFrameRef_Read);
     }
 
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -1494,7 +1580,7 @@ void WrappedOpenGL::glUseProgramStages(GLuint pipeline, GLbitfield stages, GLuin
 
       if(record->UpdateCount > 10)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -0,0 +1,695 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+// On replay we query binding and enable state a lot - GLRenderState::FetchState, and the emulated
+// DSA functions which save and restore the binding they use. On drivers that run on a separate
+// thread every glGet is a synchronising stall, so on replay the dispatch table's bind and enable
+// functions are wrapped to keep a shadow copy of that state per context, and queries for it are
+// answered from the shadow.
+//
+// A value is only in the shadow once it has been set or queried since the context was created,
+// and anything that changes it in a way we don't track exactly (e.g. deleting a bound object)
+// removes it, so it's fetched from the driver again next time.
+
+#include <map>
+#include "driver/gl/gl_common.h"
+#include "driver/gl/gl_dispatch_table.h"
+#include "driver/gl/gl_driver.h"
+#include "driver/gl/gl_resources.h"
+
+// enable this to check every shadowed query against the driver, and report any mismatches
+#define VALIDATE_SHADOWED_STATE OPTION_OFF
+
+namespace glShadow
+{
+PFNGLENABLEPROC glEnable_real = NULL;
+PFNGLDISABLEPROC glDisable_real = NULL;
+PFNGLENABLEIPROC glEnablei_real = NULL;
+PFNGLDISABLEIPROC glDisablei_real = NULL;
+PFNGLISENABLEDPROC glIsEnabled_real = NULL;
+PFNGLGETINTEGERVPROC glGetIntegerv_real = NULL;
+PFNGLACTIVETEXTUREPROC glActiveTexture_real = NULL;
+PFNGLBINDTEXTUREPROC glBindTexture_real = NULL;
+PFNGLBINDTEXTUREUNITPROC glBindTextureUnit_real = NULL;
+PFNGLBINDTEXTURESPROC glBindTextures_real = NULL;
+PFNGLBINDMULTITEXTUREEXTPROC glBindMultiTextureEXT_real = NULL;
+PFNGLDELETETEXTURESPROC glDeleteTextures_real = NULL;
+PFNGLBINDSAMPLERPROC glBindSampler_real = NULL;
+PFNGLBINDSAMPLERSPROC glBindSamplers_real = NULL;
+PFNGLDELETESAMPLERSPROC glDeleteSamplers_real = NULL;
+PFNGLBINDBUFFERPROC glBindBuffer_real = NULL;
+PFNGLBINDBUFFERBASEPROC glBindBufferBase_real = NULL;
+PFNGLBINDBUFFERRANGEPROC glBindBufferRange_real = NULL;
+PFNGLBINDBUFFERSBASEPROC glBindBuffersBase_real = NULL;
+PFNGLBINDBUFFERSRANGEPROC glBindBuffersRange_real = NULL;
+PFNGLDELETEBUFFERSPROC glDeleteBuffers_real = NULL;
+PFNGLBINDFRAMEBUFFERPROC glBindFramebuffer_real = NULL;
+PFNGLDELETEFRAMEBUFFERSPROC glDeleteFramebuffers_real = NULL;
+PFNGLBINDRENDERBUFFERPROC glBindRenderbuffer_real = NULL;
+PFNGLDELETERENDERBUFFERSPROC glDeleteRenderbuffers_real = NULL;
+PFNGLBINDVERTEXARRAYPROC glBindVertexArray_real = NULL;
+PFNGLDELETEVERTEXARRAYSPROC glDeleteVertexArrays_real = NULL;
+PFNGLVERTEXARRAYELEMENTBUFFERPROC glVertexArrayElementBuffer_real = NULL;
+PFNGLUSEPROGRAMPROC glUseProgram_real = NULL;
+PFNGLBINDTRANSFORMFEEDBACKPROC glBindTransformFeedback_real = NULL;
+PFNGLDELETETRANSFORMFEEDBACKSPROC glDeleteTransformFeedbacks_real = NULL;
+
+WrappedOpenGL *driver = NULL;
+
+enum class StateType
+{
+  NotShadowed,
+  // implementation limits, which never change
+  Limit,
+  ActiveTexture,
+  // per texture unit
+  Texture,
+  Sampler,
+  Buffer,
+  // part of the VAO state
+  ElementBuffer,
+  Framebuffer,
+  Renderbuffer,
+  VertexArray,
+  Program,
+  Feedback,
+};
+
+static StateType GetStateType(GLenum pname)
+{
+  switch(pname)
+  {
+    case eGL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+    case eGL_MAX_TEXTURE_IMAGE_UNITS:
+    case eGL_MAX_IMAGE_UNITS:
+    case eGL_MAX_VERTEX_ATTRIBS:
+    case eGL_MAX_VERTEX_ATTRIB_BINDINGS:
+    case eGL_MAX_DRAW_BUFFERS:
+    case eGL_MAX_COLOR_ATTACHMENTS:
+    case eGL_MAX_VIEWPORTS:
+    case eGL_MAX_CLIP_DISTANCES:
+    case eGL_MAX_UNIFORM_BUFFER_BINDINGS:
+    case eGL_MAX_SHADER_STORAGE_BUFFER_BINDINGS:
+    case eGL_MAX_ATOMIC_COUNTER_BUFFER_BINDINGS:
+    case eGL_MAX_TRANSFORM_FEEDBACK_BUFFERS: return StateType::Limit;
+    case eGL_ACTIVE_TEXTURE: return StateType::ActiveTexture;
+    case eGL_TEXTURE_BINDING_1D:
+    case eGL_TEXTURE_BINDING_1D_ARRAY:
+    case eGL_TEXTURE_BINDING_2D:
+    case eGL_TEXTURE_BINDING_2D_ARRAY:
+    case eGL_TEXTURE_BINDING_2D_MULTISAMPLE:
+    case eGL_TEXTURE_BINDING_2D_MULTISAMPLE_ARRAY:
+    case eGL_TEXTURE_BINDING_RECTANGLE:
+    case eGL_TEXTURE_BINDING_3D:
+    case eGL_TEXTURE_BINDING_CUBE_MAP:
+    case eGL_TEXTURE_BINDING_CUBE_MAP_ARRAY:
+    case eGL_TEXTURE_BINDING_BUFFER: return StateType::Texture;
+    case eGL_SAMPLER_BINDING: return StateType::Sampler;
+    case eGL_ARRAY_BUFFER_BINDING:
+    case eGL_ATOMIC_COUNTER_BUFFER_BINDING:
+    case eGL_COPY_READ_BUFFER_BINDING:
+    case eGL_COPY_WRITE_BUFFER_BINDING:
+    case eGL_DRAW_INDIRECT_BUFFER_BINDING:
+    case eGL_DISPATCH_INDIRECT_BUFFER_BINDING:
+    case eGL_PIXEL_PACK_BUFFER_BINDING:
+    case eGL_PIXEL_UNPACK_BUFFER_BINDING:
+    case eGL_QUERY_BUFFER_BINDING:
+    case eGL_SHADER_STORAGE_BUFFER_BINDING:
+    case eGL_TEXTURE_BUFFER_BINDING:
+    case eGL_TRANSFORM_FEEDBACK_BUFFER_BINDING:
+    case eGL_UNIFORM_BUFFER_BINDING:
+    case eGL_PARAMETER_BUFFER_BINDING_ARB: return StateType::Buffer;
+    case eGL_ELEMENT_ARRAY_BUFFER_BINDING: return StateType::ElementBuffer;
+    case eGL_DRAW_FRAMEBUFFER_BINDING:
+    case eGL_READ_FRAMEBUFFER_BINDING: return StateType::Framebuffer;
+    case eGL_RENDERBUFFER_BINDING: return StateType::Renderbuffer;
+    case eGL_VERTEX_ARRAY_BINDING: return StateType::VertexArray;
+    case eGL_CURRENT_PROGRAM: return StateType::Program;
+    case eGL_TRANSFORM_FEEDBACK_BINDING: return StateType::Feedback;
+    default: break;
+  }
+
+  return StateType::NotShadowed;
+}
+
+static bool IsPerUnit(StateType type)
+{
+  return type == StateType::Texture || type == StateType::Sampler;
+}
+
+// the texture binding query for a bind target, or GL_NONE for targets we don't shadow
+static GLenum TextureBindingQuery(GLenum target)
+{
+  switch(target)
+  {
+    case eGL_TEXTURE_1D:
+    case eGL_TEXTURE_1D_ARRAY:
+    case eGL_TEXTURE_2D:
+    case eGL_TEXTURE_2D_ARRAY:
+    case eGL_TEXTURE_2D_MULTISAMPLE:
+    case eGL_TEXTURE_2D_MULTISAMPLE_ARRAY:
+    case eGL_TEXTURE_RECTANGLE:
+    case eGL_TEXTURE_3D:
+    case eGL_TEXTURE_CUBE_MAP:
+    case eGL_TEXTURE_CUBE_MAP_ARRAY:
+    case eGL_TEXTURE_BUFFER: return TextureBinding(target);
+    default: break;
+  }
+
+  return eGL_NONE;
+}
+
+// the buffer binding query for a bind target, or GL_NONE for targets we don't shadow
+static GLenum BufferBindingQuery(GLenum target)
+{
+  switch(target)
+  {
+    case eGL_ARRAY_BUFFER:
+    case eGL_ATOMIC_COUNTER_BUFFER:
+    case eGL_COPY_READ_BUFFER:
+    case eGL_COPY_WRITE_BUFFER:
+    case eGL_DRAW_INDIRECT_BUFFER:
+    case eGL_DISPATCH_INDIRECT_BUFFER:
+    case eGL_ELEMENT_ARRAY_BUFFER:
+    case eGL_PIXEL_PACK_BUFFER:
+    case eGL_PIXEL_UNPACK_BUFFER:
+    case eGL_QUERY_BUFFER:
+    case eGL_SHADER_STORAGE_BUFFER:
+    case eGL_TEXTURE_BUFFER:
+    case eGL_TRANSFORM_FEEDBACK_BUFFER:
+    case eGL_UNIFORM_BUFFER:
+    case eGL_PARAMETER_BUFFER_ARB: return BufferBinding(target);
+    default: break;
+  }
+
+  return eGL_NONE;
+}
+
+struct ContextState
+{
+  // integer state, keyed by the query pname. Per-unit state has the unit + 1 in the upper 32 bits
+  std::map<uint64_t, GLint> values;
+  std::map<GLenum, GLboolean> enabled;
+
+  static uint64_t Key(GLenum pname, uint32_t unit) { return (uint64_t(unit + 1) << 32) | pname; }
+  static uint64_t Key(GLenum pname) { return uint64_t(pname); }
+  void Set(uint64_t key, GLint value) { values[key] = value; }
+  void Forget(StateType type)
+  {
+    for(auto it = values.begin(); it != values.end();)
+    {
+      if(GetStateType(GLenum(it->first & 0xffffffff)) == type)
+        it = values.erase(it);
+      else
+        ++it;
+    }
+  }
+  void ForgetUnit(StateType type, uint32_t unit)
+  {
+    for(auto it = values.begin(); it != values.end();)
+    {
+      if((it->first >> 32) == unit + 1 && GetStateType(GLenum(it->first & 0xffffffff)) == type)
+        it = values.erase(it);
+      else
+        ++it;
+    }
+  }
+};
+
+static std::map<void *, ContextState> contexts;
+static void *lastContext = NULL;
+static ContextState *lastState = NULL;
+
+// returns NULL if there's no context, in which case nothing is shadowed
+static ContextState *GetState()
+{
+  void *ctx = driver ? driver->GetCtx().ctx : NULL;
+
+  if(ctx == NULL)
+    return NULL;
+
+  if(ctx != lastContext)
+  {
+    lastContext = ctx;
+    lastState = &contexts[ctx];
+  }
+
+  return lastState;
+}
+
+static bool ShadowedValue(ContextState *state, GLenum pname, uint64_t key, GLint &value)
+{
+  auto it = state->values.find(key);
+  if(it == state->values.end())
+    return false;
+
+#if ENABLED(VALIDATE_SHADOWED_STATE)
+  GLint real = 0;
+  glGetIntegerv_real(pname, &real);
+  if(real != it->second)
+  {
+    RDCERR("Shadowed %s is %d, but driver has %d", ToStr(pname).c_str(), it->second, real);
+    it->second = real;
+  }
+#endif
+
+  value = it->second;
+  return true;
+}
+
+static uint32_t ActiveUnit(ContextState *state)
+{
+  GLint active = 0;
+  if(!ShadowedValue(state, eGL_ACTIVE_TEXTURE, ContextState::Key(eGL_ACTIVE_TEXTURE), active))
+  {
+    glGetIntegerv_real(eGL_ACTIVE_TEXTURE, &active);
+    state->Set(ContextState::Key(eGL_ACTIVE_TEXTURE), active);
+  }
+
+  return uint32_t(active - eGL_TEXTURE0);
+}
+
+void APIENTRY _glGetIntegerv(GLenum pname, GLint *params)
+{
+  StateType type = GetStateType(pname);
+  ContextState *state = type == StateType::NotShadowed ? NULL : GetState();
+
+  if(state == NULL)
+    return glGetIntegerv_real(pname, params);
+
+  uint64_t key = IsPerUnit(type) ? ContextState::Key(pname, ActiveUnit(state))
+                                 : ContextState::Key(pname);
+
+  if(ShadowedValue(state, pname, key, *params))
+    return;
+
+  glGetIntegerv_real(pname, params);
+  state->Set(key, *params);
+}
+
+GLboolean APIENTRY _glIsEnabled(GLenum cap)
+{
+  ContextState *state = GetState();
+
+  if(state == NULL)
+    return glIsEnabled_real(cap);
+
+  auto it = state->enabled.find(cap);
+  if(it != state->enabled.end())
+  {
+#if ENABLED(VALIDATE_SHADOWED_STATE)
+    GLboolean real = glIsEnabled_real(cap);
+    if(real != it->second)
+    {
+      RDCERR("Shadowed %s is %s, but driver has %s", ToStr(cap).c_str(),
+             it->second ? "enabled" : "disabled", real ? "enabled" : "disabled");
+      it->second = real;
+    }
+#endif
+
+    return it->second;
+  }
+
+  GLboolean ret = glIsEnabled_real(cap);
+  state->enabled[cap] = ret;
+  return ret;
+}
+
+// enables are only updated once the cap has been queried, so that a cap the driver doesn't
+// support is never reported as enabled
+void APIENTRY _glEnable(GLenum cap)
+{
+  glEnable_real(cap);
+
+  ContextState *state = GetState();
+  if(state)
+  {
+    auto it = state->enabled.find(cap);
+    if(it != state->enabled.end())
+      it->second = GL_TRUE;
+  }
+}
+
+void APIENTRY _glDisable(GLenum cap)
+{
+  glDisable_real(cap);
+
+  ContextState *state = GetState();
+  if(state)
+  {
+    auto it = state->enabled.find(cap);
+    if(it != state->enabled.end())
+      it->second = GL_FALSE;
+  }
+}
+
+// the non-indexed query returns index 0, so forget the cap if any index changes
+void APIENTRY _glEnablei(GLenum cap, GLuint index)
+{
+  glEnablei_real(cap, index);
+
+  ContextState *state = GetState();
+  if(state)
+    state->enabled.erase(cap);
+}
+
+void APIENTRY _glDisablei(GLenum cap, GLuint index)
+{
+  glDisablei_real(cap, index);
+
+  ContextState *state = GetState();
+  if(state)
+    state->enabled.erase(cap);
+}
+
+void APIENTRY _glActiveTexture(GLenum texture)
+{
+  glActiveTexture_real(texture);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Set(ContextState::Key(eGL_ACTIVE_TEXTURE), GLint(texture));
+}
+
+void APIENTRY _glBindTexture(GLenum target, GLuint texture)
+{
+  glBindTexture_real(target, texture);
+
+  ContextState *state = GetState();
+  GLenum query = TextureBindingQuery(target);
+  if(state && query != eGL_NONE)
+    state->Set(ContextState::Key(query, ActiveUnit(state)), GLint(texture));
+}
+
+void APIENTRY _glBindMultiTextureEXT(GLenum texunit, GLenum target, GLuint texture)
+{
+  glBindMultiTextureEXT_real(texunit, target, texture);
+
+  ContextState *state = GetState();
+  GLenum query = TextureBindingQuery(target);
+  if(state && query != eGL_NONE)
+    state->Set(ContextState::Key(query, texunit - eGL_TEXTURE0), GLint(texture));
+}
+
+// these bind to a target that depends on the texture, so forget the whole unit
+void APIENTRY _glBindTextureUnit(GLuint unit, GLuint texture)
+{
+  glBindTextureUnit_real(unit, texture);
+
+  ContextState *state = GetState();
+  if(state)
+    state->ForgetUnit(StateType::Texture, unit);
+}
+
+void APIENTRY _glBindTextures(GLuint first, GLsizei count, const GLuint *textures)
+{
+  glBindTextures_real(first, count, textures);
+
+  ContextState *state = GetState();
+  for(GLsizei i = 0; state && i < count; i++)
+    state->ForgetUnit(StateType::Texture, first + i);
+}
+
+void APIENTRY _glDeleteTextures(GLsizei n, const GLuint *textures)
+{
+  glDeleteTextures_real(n, textures);
+
+  // deleted textures are unbound from every unit
+  ContextState *state = GetState();
+  if(state)
+    state->Forget(StateType::Texture);
+}
+
+void APIENTRY _glBindSampler(GLuint unit, GLuint sampler)
+{
+  glBindSampler_real(unit, sampler);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Set(ContextState::Key(eGL_SAMPLER_BINDING, unit), GLint(sampler));
+}
+
+void APIENTRY _glBindSamplers(GLuint first, GLsizei count, const GLuint *samplers)
+{
+  glBindSamplers_real(first, count, samplers);
+
+  ContextState *state = GetState();
+  for(GLsizei i = 0; state && i < count; i++)
+    state->ForgetUnit(StateType::Sampler, first + i);
+}
+
+void APIENTRY _glDeleteSamplers(GLsizei count, const GLuint *samplers)
+{
+  glDeleteSamplers_real(count, samplers);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Forget(StateType::Sampler);
+}
+
+void APIENTRY _glBindBuffer(GLenum target, GLuint buffer)
+{
+  glBindBuffer_real(target, buffer);
+
+  ContextState *state = GetState();
+  GLenum query = BufferBindingQuery(target);
+  if(state && query != eGL_NONE)
+    state->Set(ContextState::Key(query), GLint(buffer));
+}
+
+// binding to an indexed target also binds to the generic target
+void APIENTRY _glBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+  glBindBufferBase_real(target, index, buffer);
+
+  ContextState *state = GetState();
+  GLenum query = BufferBindingQuery(target);
+  if(state && query != eGL_NONE)
+    state->Set(ContextState::Key(query), GLint(buffer));
+}
+
+void APIENTRY _glBindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset,
+                                 GLsizeiptr size)
+{
+  glBindBufferRange_real(target, index, buffer, offset, size);
+
+  ContextState *state = GetState();
+  GLenum query = BufferBindingQuery(target);
+  if(state && query != eGL_NONE)
+    state->Set(ContextState::Key(query), GLint(buffer));
+}
+
+void APIENTRY _glBindBuffersBase(GLenum target, GLuint first, GLsizei count, const GLuint *buffers)
+{
+  glBindBuffersBase_real(target, first, count, buffers);
+
+  ContextState *state = GetState();
+  GLenum query = BufferBindingQuery(target);
+  if(state && query != eGL_NONE)
+    state->values.erase(ContextState::Key(query));
+}
+
+void APIENTRY _glBindBuffersRange(GLenum target, GLuint first, GLsizei count,
+                                  const GLuint *buffers, const GLintptr *offsets,
+                                  const GLsizeiptr *sizes)
+{
+  glBindBuffersRange_real(target, first, count, buffers, offsets, sizes);
+
+  ContextState *state = GetState();
+  GLenum query = BufferBindingQuery(target);
+  if(state && query != eGL_NONE)
+    state->values.erase(ContextState::Key(query));
+}
+
+void APIENTRY _glDeleteBuffers(GLsizei n, const GLuint *buffers)
+{
+  glDeleteBuffers_real(n, buffers);
+
+  ContextState *state = GetState();
+  if(state)
+  {
+    state->Forget(StateType::Buffer);
+    state->Forget(StateType::ElementBuffer);
+  }
+}
+
+void APIENTRY _glBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+  glBindFramebuffer_real(target, framebuffer);
+
+  ContextState *state = GetState();
+  if(state == NULL)
+    return;
+
+  if(target == eGL_FRAMEBUFFER || target == eGL_DRAW_FRAMEBUFFER)
+    state->Set(ContextState::Key(eGL_DRAW_FRAMEBUFFER_BINDING), GLint(framebuffer));
+  if(target == eGL_FRAMEBUFFER || target == eGL_READ_FRAMEBUFFER)
+    state->Set(ContextState::Key(eGL_READ_FRAMEBUFFER_BINDING), GLint(framebuffer));
+}
+
+void APIENTRY _glDeleteFramebuffers(GLsizei n, const GLuint *framebuffers)
+{
+  glDeleteFramebuffers_real(n, framebuffers);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Forget(StateType::Framebuffer);
+}
+
+void APIENTRY _glBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+  glBindRenderbuffer_real(target, renderbuffer);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Set(ContextState::Key(eGL_RENDERBUFFER_BINDING), GLint(renderbuffer));
+}
+
+void APIENTRY _glDeleteRenderbuffers(GLsizei n, const GLuint *renderbuffers)
+{
+  glDeleteRenderbuffers_real(n, renderbuffers);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Forget(StateType::Renderbuffer);
+}
+
+void APIENTRY _glBindVertexArray(GLuint array)
+{
+  glBindVertexArray_real(array);
+
+  ContextState *state = GetState();
+  if(state)
+  {
+    state->Set(ContextState::Key(eGL_VERTEX_ARRAY_BINDING), GLint(array));
+    state->Forget(StateType::ElementBuffer);
+  }
+}
+
+void APIENTRY _glDeleteVertexArrays(GLsizei n, const GLuint *arrays)
+{
+  glDeleteVertexArrays_real(n, arrays);
+
+  ContextState *state = GetState();
+  if(state)
+  {
+    state->Forget(StateType::VertexArray);
+    state->Forget(StateType::ElementBuffer);
+  }
+}
+
+void APIENTRY _glVertexArrayElementBuffer(GLuint vaobj, GLuint buffer)
+{
+  glVertexArrayElementBuffer_real(vaobj, buffer);
+
+  // this might be the bound VAO
+  ContextState *state = GetState();
+  if(state)
+    state->Forget(StateType::ElementBuffer);
+}
+
+void APIENTRY _glUseProgram(GLuint program)
+{
+  glUseProgram_real(program);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Set(ContextState::Key(eGL_CURRENT_PROGRAM), GLint(program));
+}
+
+void APIENTRY _glBindTransformFeedback(GLenum target, GLuint id)
+{
+  glBindTransformFeedback_real(target, id);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Set(ContextState::Key(eGL_TRANSFORM_FEEDBACK_BINDING), GLint(id));
+}
+
+void APIENTRY _glDeleteTransformFeedbacks(GLsizei n, const GLuint *ids)
+{
+  glDeleteTransformFeedbacks_real(n, ids);
+
+  ContextState *state = GetState();
+  if(state)
+    state->Forget(StateType::Feedback);
+}
+
+};    // namespace glShadow
+
+void GLDispatchTable::ShadowReplayState(WrappedOpenGL *driver)
+{
+  glShadow::driver = driver;
+
+// functions the driver doesn't have are left alone, nothing can change their state
+#define SHADOW_FUNC(func)                         \
+  if(this->func && !glShadow::CONCAT(func, _real)) \
+  {                                                \
+    glShadow::CONCAT(func, _real) = this->func;    \
+    this->func = &CONCAT(glShadow::_, func);       \
+  }
+
+  // we need to be able to query anything we shadow
+  if(!this->glGetIntegerv || !this->glIsEnabled)
+    return;
+
+  SHADOW_FUNC(glEnable);
+  SHADOW_FUNC(glDisable);
+  SHADOW_FUNC(glEnablei);
+  SHADOW_FUNC(glDisablei);
+  SHADOW_FUNC(glIsEnabled);
+  SHADOW_FUNC(glGetIntegerv);
+  SHADOW_FUNC(glActiveTexture);
+  SHADOW_FUNC(glBindTexture);
+  SHADOW_FUNC(glBindTextureUnit);
+  SHADOW_FUNC(glBindTextures);
+  SHADOW_FUNC(glBindMultiTextureEXT);
+  SHADOW_FUNC(glDeleteTextures);
+  SHADOW_FUNC(glBindSampler);
+  SHADOW_FUNC(glBindSamplers);
+  SHADOW_FUNC(glDeleteSamplers);
+  SHADOW_FUNC(glBindBuffer);
+  SHADOW_FUNC(glBindBufferBase);
+  SHADOW_FUNC(glBindBufferRange);
+  SHADOW_FUNC(glBindBuffersBase);
+  SHADOW_FUNC(glBindBuffersRange);
+  SHADOW_FUNC(glDeleteBuffers);
+  SHADOW_FUNC(glBindFramebuffer);
+  SHADOW_FUNC(glDeleteFramebuffers);
+  SHADOW_FUNC(glBindRenderbuffer);
+  SHADOW_FUNC(glDeleteRenderbuffers);
+  SHADOW_FUNC(glBindVertexArray);
+  SHADOW_FUNC(glDeleteVertexArrays);
+  SHADOW_FUNC(glVertexArrayElementBuffer);
+  SHADOW_FUNC(glUseProgram);
+  SHADOW_FUNC(glBindTransformFeedback);
+  SHADOW_FUNC(glDeleteTransformFeedbacks);
+}
+
+void GLDispatchTable::ResetShadowedState(void *ctx)
+{
+  glShadow::contexts.erase(ctx);
+  glShadow::lastContext = NULL;
+  glShadow::lastState = NULL;
+}
@@ -287,8 +287,11 @@ void WrappedOpenGL::glBindTexture(GLenum target, GLuint texture)
   }
   else if(IsBackgroundCapturing(m_State))
   {
-    m_Textures[GetResourceManager()->GetID(TextureRes(GetCtx(), texture))].curType =
-        TextureTarget(target);
+    // m_Textures can't be inserted into here since other threads may be reading it concurrently,
+    // see IsSharedLockGLCall. Every texture already has an entry from when it was created.
+    auto it = m_Textures.find(GetResourceManager()->GetID(TextureRes(GetCtx(), texture)));
+    if(it != m_Textures.end())
+      it->second.curType = TextureTarget(target);
   }
 
   ContextData &cd = GetCtxData();
@@ -304,6 +307,8 @@ void WrappedOpenGL::glBindTexture(GLenum target, GLuint texture)
     GLResourceRecord *r = GetResourceManager()->GetResourceRecord(TextureRes(GetCtx(), texture));
     cd.SetActiveTexRecord(target, r);
 
+    // another thread could be binding the same texture for the first time
+    r->LockChunks();
     if(r->datatype)
     {
       // it's illegal to retype a texture
@@ -325,6 +330,7 @@ void WrappedOpenGL::glBindTexture(GLenum target, GLuint texture)
 
       r->AddChunk(chunk);
     }
+    r->UnlockChunks();
   }
 }
 
@@ -458,8 +464,11 @@ void WrappedOpenGL::glBindMultiTextureEXT(GLenum texunit, GLenum target, GLuint
   }
   else if(IsBackgroundCapturing(m_State))
   {
-    m_Textures[GetResourceManager()->GetID(TextureRes(GetCtx(), texture))].curType =
-        TextureTarget(target);
+    // m_Textures can't be inserted into here since other threads may be reading it concurrently,
+    // see IsSharedLockGLCall. Every texture already has an entry from when it was created.
+    auto it = m_Textures.find(GetResourceManager()->GetID(TextureRes(GetCtx(), texture)));
+    if(it != m_Textures.end())
+      it->second.curType = TextureTarget(target);
   }
 
   ContextData &cd = GetCtxData();
@@ -1488,8 +1497,7 @@ void WrappedOpenGL::Common_glTextureParameteriEXT(GLResourceRecord *record, GLen
     return;
   }
 
-  if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-     IsBackgroundCapturing(m_State))
+  if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
     return;
 
   // CLAMP isn't supported (border texels gone), assume they meant CLAMP_TO_EDGE
@@ -1513,7 +1521,7 @@ void WrappedOpenGL::Common_glTextureParameteriEXT(GLResourceRecord *record, GLen
 
     if(record->UpdateCount > 12)
     {
-      m_HighTrafficResources.insert(record->GetResourceID());
+      m_HighTrafficResources.Set(record->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
     }
   }
@@ -1604,7 +1612,7 @@ void WrappedOpenGL::Common_glTextureParameterivEXT(GLResourceRecord *record, GLe
   }
 
   if(IsBackgroundCapturing(m_State) &&
-     m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end())
+     m_HighTrafficResources.Contains(record->GetResourceID()))
     return;
 
   GLint clamptoedge[4] = {eGL_CLAMP_TO_EDGE};
@@ -1629,7 +1637,7 @@ void WrappedOpenGL::Common_glTextureParameterivEXT(GLResourceRecord *record, GLe
 
     if(record->UpdateCount > 12)
     {
-      m_HighTrafficResources.insert(record->GetResourceID());
+      m_HighTrafficResources.Set(record->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
     }
   }
@@ -1722,8 +1730,7 @@ void WrappedOpenGL::Common_glTextureParameterIivEXT(GLResourceRecord *record, GL
     return;
   }
 
-  if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-     IsBackgroundCapturing(m_State))
+  if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
     return;
 
   GLint clamptoedge[4] = {eGL_CLAMP_TO_EDGE};
@@ -1748,7 +1755,7 @@ void WrappedOpenGL::Common_glTextureParameterIivEXT(GLResourceRecord *record, GL
 
     if(record->UpdateCount > 12)
     {
-      m_HighTrafficResources.insert(record->GetResourceID());
+      m_HighTrafficResources.Set(record->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
     }
   }
@@ -1841,8 +1848,7 @@ void WrappedOpenGL::Common_glTextureParameterIuivEXT(GLResourceRecord *record, G
     return;
   }
 
-  if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-     IsBackgroundCapturing(m_State))
+  if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
     return;
 
   GLuint clamptoedge[4] = {eGL_CLAMP_TO_EDGE};
@@ -1867,7 +1873,7 @@ void WrappedOpenGL::Common_glTextureParameterIuivEXT(GLResourceRecord *record, G
 
     if(record->UpdateCount > 12)
     {
-      m_HighTrafficResources.insert(record->GetResourceID());
+      m_HighTrafficResources.Set(record->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
     }
   }
@@ -1959,8 +1965,7 @@ void WrappedOpenGL::Common_glTextureParameterfEXT(GLResourceRecord *record, GLen
     return;
   }
 
-  if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-     IsBackgroundCapturing(m_State))
+  if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
     return;
 
   // CLAMP isn't supported (border texels gone), assume they meant CLAMP_TO_EDGE
@@ -1984,7 +1989,7 @@ void WrappedOpenGL::Common_glTextureParameterfEXT(GLResourceRecord *record, GLen
 
     if(record->UpdateCount > 12)
     {
-      m_HighTrafficResources.insert(record->GetResourceID());
+      m_HighTrafficResources.Set(record->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
     }
   }
@@ -2074,8 +2079,7 @@ void WrappedOpenGL::Common_glTextureParameterfvEXT(GLResourceRecord *record, GLe
     return;
   }
 
-  if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-     IsBackgroundCapturing(m_State))
+  if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
     return;
 
   GLfloat clamptoedge[4] = {(float)eGL_CLAMP_TO_EDGE};
@@ -2100,7 +2104,7 @@ void WrappedOpenGL::Common_glTextureParameterfvEXT(GLResourceRecord *record, GLe
 
     if(record->UpdateCount > 12)
     {
-      m_HighTrafficResources.insert(record->GetResourceID());
+      m_HighTrafficResources.Set(record->GetResourceID(), true);
       GetResourceManager()->MarkDirtyResource(record->GetResourceID());
     }
   }
@@ -4954,8 +4958,7 @@ void WrappedOpenGL::Common_glTextureSubImage1DEXT(GLResourceRecord *record, GLen
   }
   else
   {
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -4977,7 +4980,7 @@ void WrappedOpenGL::Common_glTextureSubImage1DEXT(GLResourceRecord *record, GLen
 
       if(record->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -5178,8 +5181,7 @@ void WrappedOpenGL::Common_glTextureSubImage2DEXT(GLResourceRecord *record, GLen
   }
   else
   {
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -5196,14 +5198,18 @@ void WrappedOpenGL::Common_glTextureSubImage2DEXT(GLResourceRecord *record, GLen
     }
     else
     {
+      // this can run concurrently on other threads uploading to the same texture, see
+      // IsSharedLockGLCall
+      record->LockChunks();
       record->AddChunk(scope.Get());
       record->UpdateCount++;
 
       if(record->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
+      record->UnlockChunks();
     }
   }
 }
@@ -5410,8 +5416,7 @@ void WrappedOpenGL::Common_glTextureSubImage3DEXT(GLResourceRecord *record, GLen
   }
   else
   {
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -5433,7 +5438,7 @@ void WrappedOpenGL::Common_glTextureSubImage3DEXT(GLResourceRecord *record, GLen
 
       if(record->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -5623,8 +5628,7 @@ void WrappedOpenGL::Common_glCompressedTextureSubImage1DEXT(GLResourceRecord *re
   }
   else
   {
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -5646,7 +5650,7 @@ void WrappedOpenGL::Common_glCompressedTextureSubImage1DEXT(GLResourceRecord *re
 
       if(record->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -5848,8 +5852,7 @@ void WrappedOpenGL::Common_glCompressedTextureSubImage2DEXT(GLResourceRecord *re
   }
   else
   {
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -5871,7 +5874,7 @@ void WrappedOpenGL::Common_glCompressedTextureSubImage2DEXT(GLResourceRecord *re
 
       if(record->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -6078,8 +6081,7 @@ void WrappedOpenGL::Common_glCompressedTextureSubImage3DEXT(GLResourceRecord *re
   }
   else
   {
-    if(m_HighTrafficResources.find(record->GetResourceID()) != m_HighTrafficResources.end() &&
-       IsBackgroundCapturing(m_State))
+    if(m_HighTrafficResources.Contains(record->GetResourceID()) && IsBackgroundCapturing(m_State))
       return;
 
     USE_SCRATCH_SERIALISER();
@@ -6102,7 +6104,7 @@ void WrappedOpenGL::Common_glCompressedTextureSubImage3DEXT(GLResourceRecord *re
 
       if(record->UpdateCount > 60)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
@@ -6627,7 +6629,7 @@ void WrappedOpenGL::glTextureFoveationParametersQCOM(GLuint texture, GLuint laye
 
       if(record->UpdateCount > 64)
       {
-        m_HighTrafficResources.insert(record->GetResourceID());
+        m_HighTrafficResources.Set(record->GetResourceID(), true);
         GetResourceManager()->MarkDirtyResource(record->GetResourceID());
       }
     }
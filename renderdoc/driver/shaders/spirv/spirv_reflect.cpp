@@ -27,6 +27,7 @@
 #include <algorithm>
 #include "maths/half_convert.h"
 #include "replay/replay_driver.h"
+#include "serialise/serialiser.h"
 #include "spirv_editor.h"
 
 void FillSpecConstantVariables(const rdcarray<ShaderConstant> &invars,
@@ -2167,9 +2168,47 @@ void Reflector::AddSignatureParameter(const bool isInput, const ShaderStage stag
 
 };    // namespace rdcspv
 
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, SPIRVPatchData::InterfaceAccess &el)
+{
+  SERIALISE_MEMBER_TYPED(uint32_t, ID);
+  SERIALISE_MEMBER_TYPED(uint32_t, structID);
+  SERIALISE_MEMBER(structMemberIndex);
+  SERIALISE_MEMBER(accessChain);
+  SERIALISE_MEMBER(isArraySubsequentElement);
+}
+
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, SPIRVPatchData &el)
+{
+  SERIALISE_MEMBER(inputs);
+  SERIALISE_MEMBER(outputs);
+  SERIALISE_MEMBER(outTopo);
+}
+
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, SpecConstant &el)
+{
+  SERIALISE_MEMBER(specID);
+  SERIALISE_MEMBER(value);
+
+  // don't serialise size_t, so the data is the same between different bit-ness
+  {
+    uint64_t dataSize = el.dataSize;
+    ser.Serialise("dataSize"_lit, dataSize);
+    if(ser.IsReading())
+      el.dataSize = (size_t)dataSize;
+  }
+}
+
+INSTANTIATE_SERIALISE_TYPE(SPIRVPatchData::InterfaceAccess);
+INSTANTIATE_SERIALISE_TYPE(SPIRVPatchData);
+INSTANTIATE_SERIALISE_TYPE(SpecConstant);
+
 #if ENABLED(ENABLE_UNIT_TESTS)
 
 #include "3rdparty/catch/catch.hpp"
+#include "common/benchmark.h"
 #include "data/glsl_shaders.h"
 #include "glslang_compile.h"
 
@@ -2216,4 +2255,146 @@ TEST_CASE("Validate SPIR-V reflection", "[spirv][reflection]")
   };
 }
 
+TEST_CASE("Serialise SPIR-V reflection", "[spirv][reflection]")
+{
+  rdcspv::Init();
+  RenderDoc::Inst().RegisterShutdownFunction(&rdcspv::Shutdown);
+
+  // an output array is exploded in the signature, so the patch data has access chains
+  std::string source = R"(
+#version 450 core
+
+layout(location = 0) in vec4 pos;
+layout(location = 0) out vec4 col[2];
+
+out gl_PerVertex
+{
+  vec4 gl_Position;
+};
+
+void main()
+{
+  gl_Position = pos;
+  col[0] = pos;
+  col[1] = pos * 2.0;
+}
+)";
+
+  std::vector<uint32_t> spirv;
+  rdcspv::CompilationSettings settings(rdcspv::InputLanguage::VulkanGLSL,
+                                       rdcspv::ShaderStage::Vertex);
+  std::string errors = rdcspv::Compile(settings, {source}, spirv);
+
+  INFO("SPIR-V compile output: " << errors);
+
+  REQUIRE(!spirv.empty());
+
+  rdcspv::Reflector spv;
+  spv.Parse(spirv);
+
+  ShaderReflection refl;
+  ShaderBindpointMapping mapping;
+  SPIRVPatchData patchData;
+  spv.MakeReflection(GraphicsAPI::Vulkan, ShaderStage::Vertex, "main", {}, refl, mapping,
+                     patchData);
+
+  REQUIRE(patchData.outputs.size() == 3);
+
+  std::vector<SpecConstant> specInfo = {{5, 0x1234567890ULL, 8}};
+
+  StreamWriter *buf = new StreamWriter(StreamWriter::DefaultScratchSize);
+
+  {
+    WriteSerialiser ser(buf, Ownership::Nothing);
+
+    SCOPED_SERIALISE_CHUNK(1);
+    SERIALISE_ELEMENT(refl);
+    SERIALISE_ELEMENT(mapping);
+    SERIALISE_ELEMENT(patchData);
+    SERIALISE_ELEMENT(specInfo);
+  }
+
+  ReadSerialiser ser(new StreamReader(buf->GetData(), buf->GetOffset()), Ownership::Stream);
+
+  ser.ReadChunk<uint32_t>();
+
+  ShaderReflection readRefl;
+  ShaderBindpointMapping readMapping;
+  SPIRVPatchData readPatchData;
+  std::vector<SpecConstant> readSpecInfo;
+
+  ser.Serialise("refl"_lit, readRefl);
+  ser.Serialise("mapping"_lit, readMapping);
+  ser.Serialise("patchData"_lit, readPatchData);
+  ser.Serialise("specInfo"_lit, readSpecInfo);
+
+  ser.EndChunk();
+
+  delete buf;
+
+  REQUIRE_FALSE(ser.IsErrored());
+
+  CHECK(readRefl.entryPoint == refl.entryPoint);
+  CHECK(readRefl.inputSignature.size() == refl.inputSignature.size());
+  CHECK(readRefl.outputSignature.size() == refl.outputSignature.size());
+  CHECK(readMapping.inputAttributes == mapping.inputAttributes);
+
+  REQUIRE(readPatchData.outputs.size() == patchData.outputs.size());
+  for(size_t i = 0; i < patchData.outputs.size(); i++)
+  {
+    const SPIRVPatchData::InterfaceAccess &a = patchData.outputs[i];
+    const SPIRVPatchData::InterfaceAccess &b = readPatchData.outputs[i];
+
+    CHECK(a.ID == b.ID);
+    CHECK(a.structID == b.structID);
+    CHECK(a.structMemberIndex == b.structMemberIndex);
+    CHECK(a.accessChain == b.accessChain);
+    CHECK(a.isArraySubsequentElement == b.isArraySubsequentElement);
+  }
+  CHECK(readPatchData.outTopo == patchData.outTopo);
+
+  REQUIRE(readSpecInfo.size() == 1);
+  CHECK(readSpecInfo[0].specID == 5);
+  CHECK(readSpecInfo[0].value == 0x1234567890ULL);
+  CHECK(readSpecInfo[0].dataSize == 8);
+}
+
+TEST_CASE("Benchmark SPIR-V parsing and reflection", "[spirv][reflection][!benchmark]")
+{
+  rdcspv::Init();
+  RenderDoc::Inst().RegisterShutdownFunction(&rdcspv::Shutdown);
+
+  // the texture display shader is one of the larger real-world shaders we have to hand
+  std::vector<uint32_t> spirv;
+  rdcspv::CompilationSettings settings(rdcspv::InputLanguage::VulkanGLSL,
+                                       rdcspv::ShaderStage::Fragment);
+  settings.debugInfo = true;
+  std::string errors = rdcspv::Compile(
+      settings, {GenerateGLSLShader(GetEmbeddedResource(glsl_texdisplay_frag), eShaderVulkan, 430)},
+      spirv);
+
+  INFO("SPIR-V compile output: " << errors);
+
+  REQUIRE(!spirv.empty());
+
+  const uint64_t bytes = spirv.size() * sizeof(uint32_t);
+
+  RunBenchmark("SPIR-V parse texdisplay.frag", bytes, [&]() {
+    rdcspv::Reflector spv;
+    spv.Parse(spirv);
+  });
+
+  RunBenchmark("SPIR-V parse and reflect texdisplay.frag", bytes, [&]() {
+    rdcspv::Reflector spv;
+    spv.Parse(spirv);
+
+    ShaderReflection refl;
+    ShaderBindpointMapping mapping;
+    SPIRVPatchData patchData;
+    spv.MakeReflection(GraphicsAPI::Vulkan, ShaderStage::Pixel, "main", {}, refl, mapping,
+                       patchData);
+    BenchmarkKeep(refl.readOnlyResources.size());
+  });
+}
+
 #endif
\ No newline at end of file
@@ -77,6 +77,10 @@ struct SpecConstant
   size_t dataSize = 0;
 };
 
+DECLARE_REFLECTION_STRUCT(SPIRVPatchData::InterfaceAccess);
+DECLARE_REFLECTION_STRUCT(SPIRVPatchData);
+DECLARE_REFLECTION_STRUCT(SpecConstant);
+
 namespace rdcspv
 {
 struct SourceFile
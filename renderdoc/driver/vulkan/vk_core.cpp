@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "vk_core.h"
+#include "api/replay/version.h"
 #include "driver/ihv/amd/amd_rgp.h"
 #include "driver/shaders/spirv/spirv_compile.h"
 #include "jpeg-compressor/jpge.h"
@@ -1464,6 +1465,13 @@ bool WrappedVulkan::Serialise_BeginCaptureFrame(SerialiserType &ser)
 
 void WrappedVulkan::StartFrameCapture(void *dev, void *wnd)
 {
+  // a triggered or application-started capture takes priority over a retroactive segment
+  if(m_RetroactiveCapture)
+  {
+    DiscardFrameCapture(dev, wnd);
+    m_RetroactiveCapture = false;
+  }
+
   if(!IsBackgroundCapturing(m_State))
     return;
 
@@ -2020,15 +2028,92 @@ void WrappedVulkan::Present(void *dev, void *wnd)
   if(!activeWindow)
     return;
 
-  if(IsActiveCapturing(m_State) && !m_AppControlledCapture)
+  if(m_RetroactiveCapture)
+    UpdateRetroactiveCapture(dev, wnd);
+  else if(IsActiveCapturing(m_State) && !m_AppControlledCapture)
     RenderDoc::Inst().EndFrameCapture(dev, wnd);
 
-  if(RenderDoc::Inst().ShouldTriggerCapture(m_FrameCounter) && IsBackgroundCapturing(m_State))
+  if(RenderDoc::Inst().ShouldTriggerCapture(m_FrameCounter) &&
+     (IsBackgroundCapturing(m_State) || m_RetroactiveCapture))
   {
     RenderDoc::Inst().StartFrameCapture(dev, wnd);
 
     m_AppControlledCapture = false;
   }
+  else if(IsBackgroundCapturing(m_State) && RenderDoc::Inst().GetRetroactiveFrames() > 0)
+  {
+    StartRetroactiveCapture(dev, wnd);
+  }
+}
+
+void WrappedVulkan::StartRetroactiveCapture(void *dev, void *wnd)
+{
+  // the segment is driven directly rather than through RenderDoc::StartFrameCapture, so that the
+  // application doesn't see IsFrameCapturing() return true for the whole time it's running.
+  PerformanceTimer timer;
+
+  StartFrameCapture(dev, wnd);
+
+  if(!IsActiveCapturing(m_State))
+    return;
+
+  m_RetroactiveCapture = true;
+  m_RetroactiveSegmentFrames = 0;
+  m_RetroactiveSnapshotMS = timer.GetMilliseconds();
+}
+
+void WrappedVulkan::UpdateRetroactiveCapture(void *dev, void *wnd)
+{
+  m_RetroactiveSegmentFrames++;
+
+  uint64_t memoryBytes = GetCaptureMemoryUsage();
+
+  RetroactiveCaptureStats stats;
+  stats.frames = m_RetroactiveSegmentFrames;
+  stats.memoryBytes = memoryBytes;
+  stats.snapshotMS = m_RetroactiveSnapshotMS;
+  RenderDoc::Inst().SetRetroactiveStats(stats);
+
+  uint64_t budgetBytes = uint64_t(RenderDoc::Inst().GetRetroactiveMemoryBudget()) * 1024 * 1024;
+
+  if(RenderDoc::Inst().ShouldWriteRetroactiveCapture())
+  {
+    RDCLOG("Writing retroactive capture of %u frames, %.2f MB held, snapshot took %.2f ms",
+           m_RetroactiveSegmentFrames, double(memoryBytes) / (1024.0 * 1024.0),
+           m_RetroactiveSnapshotMS);
+
+    EndFrameCapture(dev, wnd);
+    m_RetroactiveCapture = false;
+  }
+  else if(m_RetroactiveSegmentFrames >= RenderDoc::Inst().GetRetroactiveFrames() ||
+          memoryBytes > budgetBytes)
+  {
+    // the segment is full, drop it and start again from a fresh snapshot on this frame
+    DiscardFrameCapture(dev, wnd);
+    m_RetroactiveCapture = false;
+  }
+}
+
+uint64_t WrappedVulkan::GetCaptureMemoryUsage()
+{
+  uint64_t ret = m_FrameCaptureRecord->ChunksSize();
+
+  {
+    SCOPED_LOCK(m_CmdBufferRecordsLock);
+
+    // the same baked command buffer can be submitted several times, only count it once
+    std::set<VkResourceRecord *> counted;
+    for(VkResourceRecord *record : m_CmdBufferRecords)
+    {
+      if(counted.insert(record).second)
+        ret += record->ChunksSize();
+    }
+  }
+
+  for(const MemoryAllocation &alloc : m_MemoryBlocks[(size_t)MemoryScope::InitialContents])
+    ret += alloc.size;
+
+  return ret;
 }
 
 void WrappedVulkan::AddResource(ResourceId id, ResourceType type, const char *defaultNamePrefix)
@@ -2078,6 +2163,16 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
     return ReplayStatus::FileIOFailed;
   }
 
+  // key the pipeline cache on the capture so that captures don't evict each others' pipelines.
+  // The device is created from the first chunks below, which is when the cache is loaded.
+  {
+    const SectionProperties &props = rdc->GetSectionProperties(sectionIdx);
+    std::string key = StringFormat::Fmt("%s_%llu_%llu", rdc->GetFilename().c_str(),
+                                        props.uncompressedSize, props.compressedSize);
+    m_CaptureCacheHash = strhash(key.c_str());
+    m_PipelineCacheFilename = StringFormat::Fmt("vkpipelines_%08x.cache", m_CaptureCacheHash);
+  }
+
   ReadSerialiser ser(reader, Ownership::Stream);
 
   ser.SetStringDatabase(&m_StringDB);
@@ -2111,6 +2206,13 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
   if(m_ReplayOptions.apiValidation)
     sink = new ScopedDebugMessageSink(this);
 
+  // reflect pipelines' shaders all together before the frame, rather than one by one as they're
+  // created
+  m_CreationInfo.m_DeferReflection = true;
+
+  if(!IsStructuredExporting(m_State))
+    LoadReflectionCache(rdc);
+
   for(;;)
   {
     PerformanceTimer timer;
@@ -2155,10 +2257,18 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
 
       m_FrameReader = new StreamReader(reader, frameDataSize);
 
+      {
+        SCOPED_TIMER("Shader reflection");
+        m_CreationInfo.FlushDeferredReflection();
+      }
+
       ReplayStatus status = ContextReplayLog(m_State, 0, 0, false);
 
       if(status != ReplayStatus::Succeeded)
         return status;
+
+      // the whole frame was just replayed, so nothing still holds its initial contents
+      GetResourceManager()->MarkAllInitialContentsDirty();
     }
 
     chunkInfos[context].total += timer.GetMilliseconds();
@@ -2171,6 +2281,9 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
 
   SAFE_DELETE(sink);
 
+  // in case there was no frame
+  m_CreationInfo.FlushDeferredReflection();
+
 #if ENABLED(RDOC_DEVEL)
   for(auto it = chunkInfos.begin(); it != chunkInfos.end(); ++it)
   {
@@ -2224,6 +2337,119 @@ ReplayStatus WrappedVulkan::ReadLogInitialisation(RDCFile *rdc, bool storeStruct
   return ReplayStatus::Succeeded;
 }
 
+// bump this whenever the contents of the shader reflection section change
+static const uint64_t ReflectionCacheVersion = 1;
+
+enum class ReflectionCacheChunk : uint32_t
+{
+  Header = 1,
+  Entries,
+};
+
+// reflection is only deterministic for a given build, and without a commit hash we can't tell
+// builds apart so nothing is loaded or saved.
+static bool ReflectionCacheSupported()
+{
+  return strncmp(GitVersionHash, "NO_GIT_COMMIT_HASH", 18) != 0;
+}
+
+void WrappedVulkan::LoadReflectionCache(RDCFile *rdc)
+{
+  m_CreationInfo.m_ReflectionCache.clear();
+  m_CreationInfo.m_ReflectionCacheDirty = false;
+
+  if(!ReflectionCacheSupported())
+    return;
+
+  int sectionIdx = rdc->SectionIndex(SectionType::ShaderReflection);
+
+  if(sectionIdx < 0 || rdc->GetSectionProperties(sectionIdx).version != ReflectionCacheVersion)
+    return;
+
+  StreamReader *reader = rdc->ReadSection(sectionIdx);
+
+  if(reader->IsErrored())
+  {
+    delete reader;
+    return;
+  }
+
+  ReadSerialiser ser(reader, Ownership::Stream);
+
+  ReflectionCacheChunk chunk = ser.ReadChunk<ReflectionCacheChunk>();
+
+  if(chunk != ReflectionCacheChunk::Header)
+    return;
+
+  std::string build;
+  SERIALISE_ELEMENT(build);
+
+  ser.EndChunk();
+
+  if(build != GitVersionHash)
+  {
+    RDCLOG("Ignoring shader reflection saved by a different build %s", build.c_str());
+    return;
+  }
+
+  chunk = ser.ReadChunk<ReflectionCacheChunk>();
+
+  if(chunk != ReflectionCacheChunk::Entries)
+    return;
+
+  std::vector<VulkanCreationInfo::ReflectionCacheEntry> entries;
+  SERIALISE_ELEMENT(entries);
+
+  ser.EndChunk();
+
+  if(ser.IsErrored())
+    return;
+
+  RDCLOG("Loaded %zu saved shader reflections", entries.size());
+
+  m_CreationInfo.m_ReflectionCache.swap(entries);
+}
+
+void WrappedVulkan::SaveReflectionCache(RDCFile *rdc)
+{
+  if(!m_CreationInfo.m_ReflectionCacheDirty || !ReflectionCacheSupported())
+    return;
+
+  m_CreationInfo.m_ReflectionCacheDirty = false;
+
+  // the capture may not be writeable, which isn't an error here. This also excludes captures that
+  // only exist in memory.
+  {
+    FILE *f = FileIO::fopen(rdc->GetFilename().c_str(), "r+b");
+    if(f == NULL)
+      return;
+    FileIO::fclose(f);
+  }
+
+  SectionProperties props = {};
+  props.type = SectionType::ShaderReflection;
+  props.version = ReflectionCacheVersion;
+  props.flags = SectionFlags::LZ4Compressed;
+  StreamWriter *w = rdc->WriteSection(props);
+
+  {
+    WriteSerialiser ser(w, Ownership::Stream);
+
+    {
+      SCOPED_SERIALISE_CHUNK(ReflectionCacheChunk::Header);
+      std::string build = GitVersionHash;
+      SERIALISE_ELEMENT(build);
+    }
+
+    {
+      SCOPED_SERIALISE_CHUNK(ReflectionCacheChunk::Entries);
+      ser.Serialise("entries"_lit, m_CreationInfo.m_ReflectionCache);
+    }
+  }
+
+  RDCLOG("Saved %zu shader reflections to capture", m_CreationInfo.m_ReflectionCache.size());
+}
+
 ReplayStatus WrappedVulkan::ContextReplayLog(CaptureState readType, uint32_t startEventID,
                                              uint32_t endEventID, bool partial)
 {
@@ -2480,7 +2706,8 @@ void WrappedVulkan::ApplyInitialContents()
   SubmitCmds();
   FlushQ();
 
-  // actually apply the initial contents here
+  // actually apply the initial contents here, skipping anything not written since the last time
+  MarkReplayedInitialContentsDirty();
   GetResourceManager()->ApplyInitialContents();
 
   // likewise again to make sure the initial states are all applied
@@ -3075,6 +3302,92 @@ void WrappedVulkan::AddFrameTerminator(uint64_t queueMarkerTag)
   SubmitCmds();
 }
 
+void WrappedVulkan::MarkInitialContentsWritten(ResourceId liveId)
+{
+  VulkanResourceManager *rm = GetResourceManager();
+  ResourceId origId = rm->GetOriginalID(liveId);
+
+  rm->MarkInitialContentsDirty(origId);
+
+  // buffers have no initial contents of their own, their data is restored through the memory
+  // they're bound to. Likewise restoring memory overwrites any images aliased with it.
+  ResourceDescription &desc = GetReplay()->GetResourceDesc(origId);
+
+  std::vector<ResourceId> memories;
+  if(desc.type == ResourceType::Buffer)
+    memories.insert(memories.end(), desc.parentResources.begin(), desc.parentResources.end());
+  else if(m_CreationInfo.m_Memory.find(liveId) != m_CreationInfo.m_Memory.end())
+    memories.push_back(origId);
+
+  for(ResourceId mem : memories)
+  {
+    rm->MarkInitialContentsDirty(mem);
+
+    for(ResourceId derived : GetReplay()->GetResourceDesc(mem).derivedResources)
+      rm->MarkInitialContentsDirty(derived);
+  }
+}
+
+void WrappedVulkan::MarkReplayedInitialContentsDirty()
+{
+  if(IsLoading(m_State))
+  {
+    GetResourceManager()->MarkAllInitialContentsDirty();
+    return;
+  }
+
+  if(!m_InitialStateWritesBuilt)
+  {
+    for(auto it = m_ResourceUses.begin(); it != m_ResourceUses.end(); ++it)
+    {
+      uint32_t firstWrite = ~0U;
+
+      for(const EventUsage &u : it->second)
+      {
+        switch(u.usage)
+        {
+          case ResourceUsage::StreamOut:
+          case ResourceUsage::VS_RWResource:
+          case ResourceUsage::HS_RWResource:
+          case ResourceUsage::DS_RWResource:
+          case ResourceUsage::GS_RWResource:
+          case ResourceUsage::PS_RWResource:
+          case ResourceUsage::CS_RWResource:
+          case ResourceUsage::All_RWResource:
+          case ResourceUsage::ColorTarget:
+          case ResourceUsage::DepthStencilTarget:
+          case ResourceUsage::Clear:
+          case ResourceUsage::GenMips:
+          case ResourceUsage::Resolve:
+          case ResourceUsage::ResolveDst:
+          case ResourceUsage::Copy:
+          case ResourceUsage::CopyDst:
+          // barriers can change the layout, which is also restored with the initial contents
+          case ResourceUsage::Barrier: firstWrite = RDCMIN(firstWrite, u.eventId); break;
+          default: break;
+        }
+      }
+
+      if(firstWrite != ~0U)
+        m_InitialStateWrites.push_back(make_rdcpair(firstWrite, it->first));
+    }
+
+    std::sort(m_InitialStateWrites.begin(), m_InitialStateWrites.end());
+
+    m_InitialStateWritesBuilt = true;
+  }
+
+  for(const rdcpair<uint32_t, ResourceId> &w : m_InitialStateWrites)
+  {
+    if(w.first > m_MaxReplayedEvent)
+      break;
+
+    MarkInitialContentsWritten(w.second);
+  }
+
+  m_MaxReplayedEvent = 0;
+}
+
 void WrappedVulkan::ReplayLog(uint32_t startEventID, uint32_t endEventID, ReplayLogType replayType)
 {
   bool partial = true;
@@ -3095,6 +3408,8 @@ void WrappedVulkan::ReplayLog(uint32_t startEventID, uint32_t endEventID, Replay
     FlushQ();
   }
 
+  m_MaxReplayedEvent = RDCMAX(m_MaxReplayedEvent, endEventID);
+
   m_State = CaptureState::ActiveReplaying;
 
   VkMarkerRegion::Set(StringFormat::Fmt("!!!!RenderDoc Internal: RenderDoc Replay %d (%d): %u->%u",
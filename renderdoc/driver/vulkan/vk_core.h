@@ -256,6 +256,12 @@ private:
   CaptureState m_State;
   bool m_AppControlledCapture;
 
+  // true while a retroactive capture segment is active. The segment runs across presents from an
+  // initial state snapshot until it's written out on request, or discarded to take a new snapshot
+  bool m_RetroactiveCapture = false;
+  uint32_t m_RetroactiveSegmentFrames = 0;
+  double m_RetroactiveSnapshotMS = 0.0;
+
   bool m_MarkedActive = false;
   uint32_t m_SubmitCounter = 0;
 
@@ -280,6 +286,12 @@ private:
   VkInitParams m_InitParams;
   uint64_t m_SectionVersion;
 
+  // hash identifying the capture being loaded, used to name on-disk caches so that different
+  // captures don't evict each others' data
+  uint32_t m_CaptureCacheHash = 0;
+  // name of the pipeline cache file for the capture being loaded, unique to that capture
+  std::string m_PipelineCacheFilename;
+
   StreamReader *m_FrameReader = NULL;
 
   std::set<std::string> m_StringDB;
@@ -468,6 +480,21 @@ private:
     // -> FlushQ() ----back to freesems-------^
   } m_InternalCmds;
 
+  // While preparing initial states at the start of a capture the copies are submitted without
+  // waiting, so the GPU works on one resource's readback while we record the next. The temporary
+  // objects used for the copies are destroyed once the batch has been waited on.
+  struct InitStateBatch
+  {
+    bool active = false;
+    uint32_t submits = 0;
+    VkDeviceSize bytes = 0;
+    std::vector<VkBuffer> buffers;
+    std::vector<VkImage> images;
+  } m_InitStateBatch;
+
+  void SubmitInitialStateCopy(VkDeviceSize bytes, bool waitNow);
+  void FlushInitialStateBatch();
+
   // Internal lumped/pooled memory allocations
 
   // Each memory scope gets a separate vector of allocation objects. The vector contains the list of
@@ -813,6 +840,10 @@ private:
   void AdvanceFrame();
   void Present(void *dev, void *wnd);
 
+  void StartRetroactiveCapture(void *dev, void *wnd);
+  void UpdateRetroactiveCapture(void *dev, void *wnd);
+  uint64_t GetCaptureMemoryUsage();
+
   void HandleVRFrameMarkers(const char *marker, VkCommandBuffer commandBuffer);
 
   template <typename SerialiserType>
@@ -834,6 +865,20 @@ private:
 
   void ApplyInitialContents();
 
+  // images and memory keep their initial contents from one full replay to the next unless something
+  // writes to them, in which case they must be marked so they're restored again. Writes that are
+  // recorded as resource usage are handled from m_InitialStateWrites, anything else must call
+  // MarkInitialContentsWritten when it's replayed.
+  void MarkInitialContentsWritten(ResourceId liveId);
+  void MarkReplayedInitialContentsDirty();
+
+  // the highest event replayed since initial contents were last applied
+  uint32_t m_MaxReplayedEvent = 0;
+  // the first event writing to each resource by live ID, sorted by event. Built on first use after
+  // loading, since the resource usage isn't complete until then.
+  std::vector<rdcpair<uint32_t, ResourceId>> m_InitialStateWrites;
+  bool m_InitialStateWritesBuilt = false;
+
   std::vector<APIEvent> m_RootEvents, m_Events;
   bool m_AddedDrawcall;
 
@@ -918,6 +963,8 @@ public:
   VulkanReplay *GetReplay() { return &m_Replay; }
   // replay interface
   bool Prepare_InitialState(WrappedVkRes *res);
+  void BeginInitialStateBatch();
+  void EndInitialStateBatch();
   uint64_t GetSize_InitialState(ResourceId id, const VkInitialContents &initial);
   uint64_t GetSize_SparseInitialState(ResourceId id, const VkInitialContents &initial);
   template <typename SerialiserType>
@@ -940,6 +987,8 @@ public:
   void Shutdown();
   void ReplayLog(uint32_t startEventID, uint32_t endEventID, ReplayLogType replayType);
   ReplayStatus ReadLogInitialisation(RDCFile *rdc, bool storeStructuredBuffers);
+  void LoadReflectionCache(RDCFile *rdc);
+  void SaveReflectionCache(RDCFile *rdc);
 
   SDFile &GetStructuredFile() { return *m_StructuredFile; }
   FrameRecord &GetFrameRecord() { return m_FrameRecord; }
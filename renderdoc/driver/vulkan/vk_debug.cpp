@@ -1049,6 +1049,16 @@ uint32_t VulkanReplay::PickVertex(uint32_t eventId, int32_t w, int32_t h, const
     }
   }
 
+  // once a BVH has been built for a triangle mesh, pick on the CPU instead
+  {
+    uint32_t vertid = ~0U;
+    if(m_PickCache.PickTriangles(eventId, cfg, true, rayPos, rayDir, vertid))
+    {
+      VkMarkerRegion::End();
+      return vertid;
+    }
+  }
+
   const bool fandecode =
       (cfg.position.topology == Topology::TriangleFan && cfg.position.allowRestart);
 
@@ -1705,6 +1715,7 @@ void VulkanReplay::CreateResources()
 
 void VulkanReplay::DestroyResources()
 {
+  SavePostVSDiskCache();
   ClearPostVSCache();
   ClearFeedbackCache();
 
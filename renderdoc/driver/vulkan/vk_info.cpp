@@ -23,6 +23,8 @@
  ******************************************************************************/
 
 #include "vk_info.h"
+#include <algorithm>
+#include "common/threading.h"
 
 VkDynamicState ConvertDynamicState(VulkanDynamicStateIndex idx)
 {
@@ -255,8 +257,8 @@ void VulkanCreationInfo::Pipeline::Init(VulkanResourceManager *resourceMan,
 
     ShaderModuleReflection &reflData = info.m_ShaderModule[shadid].m_Reflections[key];
 
-    reflData.Init(resourceMan, shadid, info.m_ShaderModule[shadid].spirv, shad.entryPoint,
-                  pCreateInfo->pStages[i].stage, shad.specialization);
+    reflData.Init(resourceMan, info, shadid, key, pCreateInfo->pStages[i].stage,
+                  shad.specialization);
 
     shad.refl = &reflData.refl;
     shad.mapping = &reflData.mapping;
@@ -586,8 +588,7 @@ void VulkanCreationInfo::Pipeline::Init(VulkanResourceManager *resourceMan, Vulk
 
     ShaderModuleReflection &reflData = info.m_ShaderModule[shadid].m_Reflections[key];
 
-    reflData.Init(resourceMan, shadid, info.m_ShaderModule[shadid].spirv, shad.entryPoint,
-                  pCreateInfo->stage.stage, shad.specialization);
+    reflData.Init(resourceMan, info, shadid, key, pCreateInfo->stage.stage, shad.specialization);
 
     shad.refl = &reflData.refl;
     shad.mapping = &reflData.mapping;
@@ -1047,28 +1048,191 @@ void VulkanCreationInfo::ShaderModule::Init(VulkanResourceManager *resourceMan,
   else
   {
     RDCASSERT(pCreateInfo->codeSize % sizeof(uint32_t) == 0);
-    spirv.Parse(std::vector<uint32_t>(
-        (uint32_t *)(pCreateInfo->pCode),
-        (uint32_t *)(pCreateInfo->pCode + pCreateInfo->codeSize / sizeof(uint32_t))));
+    // only keep the words for now, they're parsed on first use in GetReflector()
+    m_SPIRVWords.assign(pCreateInfo->pCode, pCreateInfo->pCode + pCreateInfo->codeSize / 4);
+
+    // 64-bit FNV-1a over the words, mixed with the length
+    spirvHash = 14695981039346656037ULL ^ m_SPIRVWords.size();
+    for(uint32_t word : m_SPIRVWords)
+      spirvHash = (spirvHash ^ word) * 1099511628211ULL;
   }
 }
 
 void VulkanCreationInfo::ShaderModuleReflection::Init(VulkanResourceManager *resourceMan,
-                                                      ResourceId id, const rdcspv::Reflector &spv,
-                                                      const std::string &entry,
+                                                      VulkanCreationInfo &info, ResourceId id,
+                                                      const ShaderModuleReflectionKey &key,
                                                       VkShaderStageFlagBits stage,
                                                       const std::vector<SpecConstant> &specInfo)
 {
   if(entryPoint.empty())
   {
-    entryPoint = entry;
+    entryPoint = key.entryPoint;
     stageIndex = StageIndex(stage);
 
-    spv.MakeReflection(GraphicsAPI::Vulkan, ShaderStage(stageIndex), entryPoint, specInfo, refl,
-                       mapping, patchData);
-
     refl.resourceId = resourceMan->GetOriginalID(id);
+
+    if(info.m_DeferReflection)
+      info.m_DeferredReflections.push_back({id, key, specInfo});
+    else
+      Reflect(info.m_ShaderModule[id].GetReflector(), specInfo);
+  }
+}
+
+void VulkanCreationInfo::ShaderModuleReflection::Reflect(const rdcspv::Reflector &spv,
+                                                         const std::vector<SpecConstant> &specInfo)
+{
+  spv.MakeReflection(GraphicsAPI::Vulkan, ShaderStage(stageIndex), entryPoint, specInfo, refl,
+                     mapping, patchData);
+}
+
+bool VulkanCreationInfo::ReflectionCacheKey::operator<(const ReflectionCacheKey &o) const
+{
+  if(spirvHash != o.spirvHash)
+    return spirvHash < o.spirvHash;
+  if(stageIndex != o.stageIndex)
+    return stageIndex < o.stageIndex;
+  if(entryPoint != o.entryPoint)
+    return entryPoint < o.entryPoint;
+  if(specInfo.size() != o.specInfo.size())
+    return specInfo.size() < o.specInfo.size();
+
+  for(size_t i = 0; i < specInfo.size(); i++)
+  {
+    const SpecConstant &a = specInfo[i];
+    const SpecConstant &b = o.specInfo[i];
+
+    if(a.specID != b.specID)
+      return a.specID < b.specID;
+    if(a.value != b.value)
+      return a.value < b.value;
+    if(a.dataSize != b.dataSize)
+      return a.dataSize < b.dataSize;
+  }
+
+  return false;
+}
+
+void VulkanCreationInfo::FlushDeferredReflection()
+{
+  m_DeferReflection = false;
+
+  if(m_DeferredReflections.empty())
+    return;
+
+  // group by module, so that each module is parsed by only one thread
+  std::sort(m_DeferredReflections.begin(), m_DeferredReflections.end(),
+            [](const DeferredReflection &a, const DeferredReflection &b) {
+              return a.module < b.module;
+            });
+
+  std::vector<size_t> moduleStarts;
+  for(size_t i = 0; i < m_DeferredReflections.size(); i++)
+  {
+    if(i == 0 || m_DeferredReflections[i].module != m_DeferredReflections[i - 1].module)
+      moduleStarts.push_back(i);
+  }
+  moduleStarts.push_back(m_DeferredReflections.size());
+
+  // look up everything before going wide, nothing is added to the maps while the threads run
+  std::vector<ShaderModule *> modules(moduleStarts.size() - 1);
+  std::vector<ShaderModuleReflection *> reflections(m_DeferredReflections.size());
+
+  for(size_t m = 0; m + 1 < moduleStarts.size(); m++)
+  {
+    auto it = m_ShaderModule.find(m_DeferredReflections[moduleStarts[m]].module);
+    modules[m] = it == m_ShaderModule.end() ? NULL : &it->second;
+
+    for(size_t i = moduleStarts[m]; modules[m] && i < moduleStarts[m + 1]; i++)
+      reflections[i] = &modules[m]->m_Reflections[m_DeferredReflections[i].key];
+  }
+
+  // fill in anything we have persisted results for, and only parse and reflect the rest
+  std::vector<ReflectionCacheKey> keys(m_DeferredReflections.size());
+  std::vector<bool> uncached(m_DeferredReflections.size(), false);
+  std::vector<bool> moduleUncached(modules.size(), false);
+
+  auto keyLess = [](const ReflectionCacheEntry &e, const ReflectionCacheKey &k) {
+    return e.key < k;
+  };
+
+  for(size_t m = 0; m < modules.size(); m++)
+  {
+    for(size_t i = moduleStarts[m]; modules[m] && i < moduleStarts[m + 1]; i++)
+    {
+      ReflectionCacheKey &key = keys[i];
+      key.spirvHash = modules[m]->spirvHash;
+      key.stageIndex = reflections[i]->stageIndex;
+      key.entryPoint = reflections[i]->entryPoint;
+      key.specInfo = m_DeferredReflections[i].specInfo;
+
+      auto it = std::lower_bound(m_ReflectionCache.begin(), m_ReflectionCache.end(), key, keyLess);
+
+      if(it != m_ReflectionCache.end() && !(key < it->key))
+      {
+        // the ID is the only thing that's per-capture rather than per-shader
+        ResourceId id = reflections[i]->refl.resourceId;
+        reflections[i]->refl = it->refl;
+        reflections[i]->refl.resourceId = id;
+        reflections[i]->mapping = it->mapping;
+        reflections[i]->patchData = it->patchData;
+      }
+      else
+      {
+        uncached[i] = moduleUncached[m] = true;
+      }
+    }
   }
+
+  Threading::ParallelFor((uint32_t)modules.size(), [&](uint32_t m) {
+    // the module may have been destroyed since
+    if(modules[m] == NULL || !moduleUncached[m])
+      return;
+
+    const rdcspv::Reflector &spv = modules[m]->GetReflector();
+
+    for(size_t i = moduleStarts[m]; i < moduleStarts[m + 1]; i++)
+    {
+      if(uncached[i])
+        reflections[i]->Reflect(spv, m_DeferredReflections[i].specInfo);
+    }
+  });
+
+  // add the new results to the cache so that they can be saved
+  bool added = false;
+  for(size_t i = 0; i < m_DeferredReflections.size(); i++)
+  {
+    if(!uncached[i])
+      continue;
+
+    ReflectionCacheEntry entry;
+    entry.key = keys[i];
+    entry.refl = reflections[i]->refl;
+    entry.mapping = reflections[i]->mapping;
+    entry.patchData = reflections[i]->patchData;
+    m_ReflectionCache.push_back(entry);
+
+    added = true;
+  }
+
+  if(added)
+  {
+    std::sort(m_ReflectionCache.begin(), m_ReflectionCache.end(),
+              [](const ReflectionCacheEntry &a, const ReflectionCacheEntry &b) {
+                return a.key < b.key;
+              });
+
+    // the same shader can be used by several pipelines
+    m_ReflectionCache.erase(
+        std::unique(m_ReflectionCache.begin(), m_ReflectionCache.end(),
+                    [](const ReflectionCacheEntry &a, const ReflectionCacheEntry &b) {
+                      return !(a.key < b.key) && !(b.key < a.key);
+                    }),
+        m_ReflectionCache.end());
+
+    m_ReflectionCacheDirty = true;
+  }
+
+  m_DeferredReflections.clear();
 }
 
 void VulkanCreationInfo::DescSetPool::Init(VulkanResourceManager *resourceMan,
@@ -161,9 +161,13 @@ struct VulkanCreationInfo
     ShaderBindpointMapping mapping;
     SPIRVPatchData patchData;
 
-    void Init(VulkanResourceManager *resourceMan, ResourceId id, const rdcspv::Reflector &spv,
-              const std::string &entry, VkShaderStageFlagBits stage,
+    // reflects immediately, or while loading queues the reflection to be done with all the others
+    // in FlushDeferredReflection.
+    void Init(VulkanResourceManager *resourceMan, VulkanCreationInfo &info, ResourceId id,
+              const ShaderModuleReflectionKey &key, VkShaderStageFlagBits stage,
               const std::vector<SpecConstant> &specInfo);
+
+    void Reflect(const rdcspv::Reflector &spv, const std::vector<SpecConstant> &specInfo);
   };
 
   struct Pipeline
@@ -511,14 +515,72 @@ struct VulkanCreationInfo
       return m_Reflections[{entry, ResourceId()}];
     }
 
-    rdcspv::Reflector spirv;
+    // the SPIR-V is only parsed the first time it's needed, since many modules in a capture are
+    // never used by a pipeline or inspected.
+    const rdcspv::Reflector &GetReflector() const
+    {
+      if(!m_SPIRVWords.empty())
+      {
+        m_SPIRV.Parse(m_SPIRVWords);
+        m_SPIRVWords.clear();
+        m_SPIRVWords.shrink_to_fit();
+      }
+
+      return m_SPIRV;
+    }
 
     std::string unstrippedPath;
 
+    // hash of the SPIR-V words, identifying the module's reflection in the persisted cache
+    uint64_t spirvHash = 0;
+
     std::map<ShaderModuleReflectionKey, ShaderModuleReflection> m_Reflections;
+
+  private:
+    mutable rdcspv::Reflector m_SPIRV;
+    mutable std::vector<uint32_t> m_SPIRVWords;
   };
   std::map<ResourceId, ShaderModule> m_ShaderModule;
 
+  // while a capture is loading, pipelines' shader reflection is queued up so it can be done in
+  // parallel once everything is created - see ShaderModuleReflection::Init
+  struct DeferredReflection
+  {
+    ResourceId module;
+    ShaderModuleReflectionKey key;
+    std::vector<SpecConstant> specInfo;
+  };
+  bool m_DeferReflection = false;
+  std::vector<DeferredReflection> m_DeferredReflections;
+
+  void FlushDeferredReflection();
+
+  // reflection results are persisted in the capture file, so that deferred reflections can be
+  // looked up instead of recomputed the next time it's opened. See
+  // WrappedVulkan::LoadReflectionCache and WrappedVulkan::SaveReflectionCache
+  struct ReflectionCacheKey
+  {
+    bool operator<(const ReflectionCacheKey &o) const;
+
+    uint64_t spirvHash = 0;
+    uint32_t stageIndex = 0;
+    rdcstr entryPoint;
+    std::vector<SpecConstant> specInfo;
+  };
+
+  struct ReflectionCacheEntry
+  {
+    ReflectionCacheKey key;
+    ShaderReflection refl;
+    ShaderBindpointMapping mapping;
+    SPIRVPatchData patchData;
+  };
+
+  // sorted by key
+  std::vector<ReflectionCacheEntry> m_ReflectionCache;
+  // set when reflections were computed that aren't in the cache
+  bool m_ReflectionCacheDirty = false;
+
   struct DescSetPool
   {
     void Init(VulkanResourceManager *resourceMan, VulkanCreationInfo &info,
@@ -563,3 +625,6 @@ struct VulkanCreationInfo
     m_Queue.erase(id);
   }
 };
+
+DECLARE_REFLECTION_STRUCT(VulkanCreationInfo::ReflectionCacheKey);
+DECLARE_REFLECTION_STRUCT(VulkanCreationInfo::ReflectionCacheEntry);
@@ -39,7 +39,8 @@
 // used across init state use, and only do a single flush. Also we could then get some
 // nice command buffer reuse (although need to be careful we don't create too large a
 // command buffer that stalls the GPU).
-// See INITSTATEBATCH
+// See INITSTATEBATCH. Preparing initial states at capture start does this already, see
+// m_InitStateBatch.
 
 bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
 {
@@ -520,18 +521,14 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
     vkr = ObjDisp(d)->EndCommandBuffer(Unwrap(cmd));
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    // INITSTATEBATCH
-    SubmitCmds();
-    FlushQ();
-
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
-    GetResourceManager()->ReleaseWrappedResource(dstBuf);
+    m_InitStateBatch.buffers.push_back(dstBuf);
 
     if(arrayIm != VK_NULL_HANDLE)
-    {
-      ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(arrayIm), NULL);
-      GetResourceManager()->ReleaseWrappedResource(arrayIm);
-    }
+      m_InitStateBatch.images.push_back(arrayIm);
+
+    // images owned by another queue family are handed back immediately above, so don't leave
+    // their copy in flight
+    SubmitInitialStateCopy(readbackmem.size, extQCmd != VK_NULL_HANDLE);
 
     GetResourceManager()->SetInitialContents(id, VkInitialContents(type, readbackmem));
 
@@ -616,14 +613,10 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
     vkr = ObjDisp(d)->EndCommandBuffer(Unwrap(cmd));
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
-    // INITSTATEBATCH
-    SubmitCmds();
-    FlushQ();
+    m_InitStateBatch.buffers.push_back(srcBuf);
+    m_InitStateBatch.buffers.push_back(dstBuf);
 
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(srcBuf), NULL);
-    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(dstBuf), NULL);
-    GetResourceManager()->ReleaseWrappedResource(srcBuf);
-    GetResourceManager()->ReleaseWrappedResource(dstBuf);
+    SubmitInitialStateCopy(datasize, false);
 
     GetResourceManager()->SetInitialContents(id, VkInitialContents(type, readbackmem));
 
@@ -637,6 +630,61 @@ bool WrappedVulkan::Prepare_InitialState(WrappedVkRes *res)
   return false;
 }
 
+void WrappedVulkan::BeginInitialStateBatch()
+{
+  m_InitStateBatch.active = true;
+}
+
+void WrappedVulkan::EndInitialStateBatch()
+{
+  m_InitStateBatch.active = false;
+  FlushInitialStateBatch();
+}
+
+void WrappedVulkan::SubmitInitialStateCopy(VkDeviceSize bytes, bool waitNow)
+{
+  SubmitCmds();
+
+  m_InitStateBatch.submits++;
+  m_InitStateBatch.bytes += bytes;
+
+  // bound how much is in flight at once, both in command buffers and in readback memory being
+  // written. Outside of a batch (e.g. a resource prepared mid-capture) wait immediately.
+  const uint32_t maxSubmits = 64;
+  const VkDeviceSize maxBytes = 256 * 1024 * 1024;
+
+  if(waitNow || !m_InitStateBatch.active || m_InitStateBatch.submits >= maxSubmits ||
+     m_InitStateBatch.bytes >= maxBytes)
+    FlushInitialStateBatch();
+}
+
+void WrappedVulkan::FlushInitialStateBatch()
+{
+  if(m_InitStateBatch.submits == 0)
+    return;
+
+  FlushQ();
+
+  VkDevice d = GetDev();
+
+  for(VkBuffer buf : m_InitStateBatch.buffers)
+  {
+    ObjDisp(d)->DestroyBuffer(Unwrap(d), Unwrap(buf), NULL);
+    GetResourceManager()->ReleaseWrappedResource(buf);
+  }
+
+  for(VkImage im : m_InitStateBatch.images)
+  {
+    ObjDisp(d)->DestroyImage(Unwrap(d), Unwrap(im), NULL);
+    GetResourceManager()->ReleaseWrappedResource(im);
+  }
+
+  m_InitStateBatch.buffers.clear();
+  m_InitStateBatch.images.clear();
+  m_InitStateBatch.submits = 0;
+  m_InitStateBatch.bytes = 0;
+}
+
 uint64_t WrappedVulkan::GetSize_InitialState(ResourceId id, const VkInitialContents &initial)
 {
   if(initial.type == eResDescriptorSet)
@@ -798,7 +798,10 @@ void VulkanResourceManager::ApplyBarriers(uint32_t queueFamilyIndex,
 
 ResourceId VulkanResourceManager::GetFirstIDForHandle(uint64_t handle)
 {
-  for(auto it = m_CurrentResourceMap.begin(); it != m_CurrentResourceMap.end(); ++it)
+  std::vector<std::pair<ResourceId, WrappedVkRes *>> resources;
+  m_CurrentResourceMap.GetAll(resources);
+
+  for(auto it = resources.begin(); it != resources.end(); ++it)
   {
     WrappedVkRes *res = it->second;
 
@@ -905,6 +908,21 @@ bool VulkanResourceManager::Prepare_InitialState(WrappedVkRes *res)
   return m_Core->Prepare_InitialState(res);
 }
 
+void VulkanResourceManager::Begin_PrepareInitialBatch()
+{
+  m_Core->BeginInitialStateBatch();
+}
+
+void VulkanResourceManager::End_PrepareInitialBatch()
+{
+  m_Core->EndInitialStateBatch();
+}
+
+std::string VulkanResourceManager::GetInitialStateTypeName(WrappedVkRes *res)
+{
+  return ToStr(IdentifyTypeByPtr(res));
+}
+
 uint64_t VulkanResourceManager::GetSize_InitialState(ResourceId id, const VkInitialContents &initial)
 {
   return m_Core->GetSize_InitialState(id, initial);
@@ -937,6 +955,27 @@ std::vector<ResourceId> VulkanResourceManager::InitialContentResources()
   return resources;
 }
 
+bool VulkanResourceManager::IsInitialStateWriteTracked(ResourceId id,
+                                                       const VkInitialContents &initial)
+{
+  // WrappedVulkan marks replayed writes to images and memory. Sparse bindings and descriptor sets
+  // can be changed by the replay in other ways, so are always applied.
+  return (initial.type == eResImage || initial.type == eResDeviceMemory) &&
+         initial.tag != VkInitialContents::Sparse;
+}
+
+uint64_t VulkanResourceManager::GetRestoreSize_InitialState(ResourceId id,
+                                                            const VkInitialContents &initial)
+{
+  if(initial.tag == VkInitialContents::Sparse)
+    return 0;
+
+  if(initial.type == eResImage || initial.type == eResDeviceMemory)
+    return initial.mem.size;
+
+  return 0;
+}
+
 bool VulkanResourceManager::ResourceTypeRelease(WrappedVkRes *res)
 {
   return m_Core->ReleaseResource(res);
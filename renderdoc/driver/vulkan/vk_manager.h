@@ -200,14 +200,14 @@ public:
     // we just have to leak ourselves.
     RDCASSERT(m_LiveResourceMap.empty());
     RDCASSERT(m_InitialContents.empty());
-    RDCASSERT(m_ResourceRecords.empty());
-    RDCASSERT(m_CurrentResourceMap.empty());
+    RDCASSERT(m_ResourceRecords.IsEmpty());
+    RDCASSERT(m_CurrentResourceMap.IsEmpty());
     RDCASSERT(m_WrapperMap.empty());
 
     m_LiveResourceMap.clear();
     m_InitialContents.clear();
-    m_ResourceRecords.clear();
-    m_CurrentResourceMap.clear();
+    m_ResourceRecords.Clear();
+    m_CurrentResourceMap.Clear();
     m_WrapperMap.clear();
   }
 
@@ -460,12 +460,17 @@ private:
   bool ResourceTypeRelease(WrappedVkRes *res);
 
   bool Prepare_InitialState(WrappedVkRes *res);
+  void Begin_PrepareInitialBatch();
+  void End_PrepareInitialBatch();
+  std::string GetInitialStateTypeName(WrappedVkRes *res);
   uint64_t GetSize_InitialState(ResourceId id, const VkInitialContents &initial);
   bool Serialise_InitialState(WriteSerialiser &ser, ResourceId id, VkResourceRecord *record,
                               const VkInitialContents *initial);
   void Create_InitialState(ResourceId id, WrappedVkRes *live, bool hasData);
   void Apply_InitialState(WrappedVkRes *live, const VkInitialContents &initial);
   std::vector<ResourceId> InitialContentResources();
+  bool IsInitialStateWriteTracked(ResourceId id, const VkInitialContents &initial);
+  uint64_t GetRestoreSize_InitialState(ResourceId id, const VkInitialContents &initial);
 
   WrappedVulkan *m_Core;
   std::map<ResourceId, MemRefs> m_MemFrameRefs;
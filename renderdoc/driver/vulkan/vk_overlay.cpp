@@ -47,12 +47,14 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
         m_Events(events),
         m_PrevState(vk, NULL)
   {
+    // sorted for lookup, large passes can contain thousands of draws
+    std::sort(m_Events.begin(), m_Events.end());
     m_pDriver->SetDrawcallCB(this);
   }
   ~VulkanQuadOverdrawCallback() { m_pDriver->SetDrawcallCB(NULL); }
   void PreDraw(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(std::find(m_Events.begin(), m_Events.end(), eid) == m_Events.end())
+    if(!std::binary_search(m_Events.begin(), m_Events.end(), eid))
       return;
 
     // we customise the pipeline to disable framebuffer writes, but perform normal testing
@@ -225,7 +227,7 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
 
   bool PostDraw(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(std::find(m_Events.begin(), m_Events.end(), eid) == m_Events.end())
+    if(!std::binary_search(m_Events.begin(), m_Events.end(), eid))
       return false;
 
     // restore the render state and go ahead with the real draw
@@ -259,7 +261,7 @@ struct VulkanQuadOverdrawCallback : public VulkanDrawcallCallback
   WrappedVulkan *m_pDriver;
   VkDescriptorSetLayout m_DescSetLayout;
   VkDescriptorSet m_DescSet;
-  const std::vector<uint32_t> &m_Events;
+  std::vector<uint32_t> m_Events;
 
   // cache modified pipelines
   struct CachedPipeline
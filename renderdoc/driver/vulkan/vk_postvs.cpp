@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include <float.h>
+#include "common/shader_cache.h"
 #include "driver/shaders/spirv/spirv_editor.h"
 #include "driver/shaders/spirv/spirv_op_helpers.h"
 #include "vk_core.h"
@@ -48,6 +49,131 @@ static const uint32_t MeshOutputTBufferArraySize = 16;
 // 4 = sint vbuffers
 static const uint32_t MeshOutputReservedBindings = 5;
 
+static const uint32_t PostVSDiskCacheMagic = 0xf00d0457;
+static const uint32_t PostVSDiskCacheVersion = 1;
+// beyond this size new results aren't added to the disk cache, since it's loaded in its entirety
+static const uint64_t PostVSDiskCacheMaxSize = 512 * 1024 * 1024;
+
+// header of each entry in the post-VS disk cache, followed by the vertex data then index data
+struct PostVSDiskCacheEntry
+{
+  VkPrimitiveTopology topo;
+  uint32_t numVerts;
+  uint32_t vertStride;
+  uint32_t instStride;
+  uint32_t numViews;
+  uint32_t useIndices;
+  VkIndexType idxFmt;
+  uint32_t hasPosOut;
+  float nearPlane;
+  float farPlane;
+  uint64_t vertexSize;
+  uint64_t indexSize;
+};
+
+struct PostVSDiskCacheCallbacks
+{
+  bool Create(uint32_t size, byte *data, bytebuf **ret) const
+  {
+    RDCASSERT(ret);
+
+    if(size < sizeof(PostVSDiskCacheEntry))
+      return false;
+
+    bytebuf *blob = new bytebuf();
+    blob->resize(size);
+    memcpy(blob->data(), data, size);
+
+    *ret = blob;
+
+    return true;
+  }
+
+  void Destroy(bytebuf *blob) const { delete blob; }
+  uint32_t GetSize(bytebuf *blob) const { return (uint32_t)blob->size(); }
+  const byte *GetData(bytebuf *blob) const { return blob->data(); }
+} VulkanPostVSCacheCallbacks;
+
+bool VulkanReplay::PostVS::PatchedShaderKey::operator<(const PatchedShaderKey &o) const
+{
+  if(module != o.module)
+    return module < o.module;
+  if(entryPoint != o.entryPoint)
+    return entryPoint < o.entryPoint;
+  if(instDivisor != o.instDivisor)
+    return instDivisor < o.instDivisor;
+  if(indexed != o.indexed)
+    return indexed < o.indexed;
+  if(numVerts != o.numVerts)
+    return numVerts < o.numVerts;
+  if(numInstances != o.numInstances)
+    return numInstances < o.numInstances;
+  if(numViews != o.numViews)
+    return numViews < o.numViews;
+  if(vertexOffset != o.vertexOffset)
+    return vertexOffset < o.vertexOffset;
+  if(instanceOffset != o.instanceOffset)
+    return instanceOffset < o.instanceOffset;
+  if(drawIndex != o.drawIndex)
+    return drawIndex < o.drawIndex;
+  return baseVertex < o.baseVertex;
+}
+
+static bool CreateFilledBuffer(WrappedVulkan *driver, VkBufferUsageFlags usage, const byte *data,
+                               uint64_t size, VkBuffer &buf, VkDeviceMemory &mem)
+{
+  VkDevice dev = driver->GetDev();
+
+  VkBufferCreateInfo bufInfo = {
+      VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO, NULL, 0, RDCMAX(size, (uint64_t)64), usage,
+  };
+
+  VkResult vkr = driver->vkCreateBuffer(dev, &bufInfo, NULL, &buf);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  VkMemoryRequirements mrq = {0};
+  driver->vkGetBufferMemoryRequirements(dev, buf, &mrq);
+
+  VkMemoryAllocateInfo allocInfo = {
+      VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO, NULL, mrq.size,
+      driver->GetUploadMemoryIndex(mrq.memoryTypeBits),
+  };
+
+  vkr = driver->vkAllocateMemory(dev, &allocInfo, NULL, &mem);
+
+  if(vkr != VK_SUCCESS)
+  {
+    RDCWARN("Failed to allocate %llu bytes for cached post-VS data", mrq.size);
+    driver->vkDestroyBuffer(dev, buf, NULL);
+    buf = VK_NULL_HANDLE;
+    mem = VK_NULL_HANDLE;
+    return false;
+  }
+
+  vkr = driver->vkBindBufferMemory(dev, buf, mem, 0);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  byte *dst = NULL;
+  vkr = driver->vkMapMemory(dev, mem, 0, VK_WHOLE_SIZE, 0, (void **)&dst);
+  RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+  if(dst)
+  {
+    memcpy(dst, data, (size_t)size);
+
+    VkMappedMemoryRange range = {
+        VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, NULL, mem, 0, VK_WHOLE_SIZE,
+    };
+
+    vkr = driver->vkFlushMappedMemoryRanges(dev, 1, &range);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    driver->vkUnmapMemory(dev, mem);
+  }
+
+  return true;
+}
+
 static void ConvertToMeshOutputCompute(const ShaderReflection &refl, const SPIRVPatchData &patchData,
                                        const char *entryName, std::vector<uint32_t> instDivisor,
                                        const DrawcallDescription *draw, uint32_t numVerts,
@@ -1174,6 +1300,154 @@ void VulkanReplay::ClearPostVSCache()
   }
 
   m_PostVS.Data.clear();
+
+  for(auto it = m_PostVS.PatchedShaders.begin(); it != m_PostVS.PatchedShaders.end(); ++it)
+    m_pDriver->vkDestroyShaderModule(dev, it->second.module, NULL);
+
+  m_PostVS.PatchedShaders.clear();
+
+  // post-transform buffers can be reused, so any BVH built from them is stale
+  m_PickCache.Clear();
+}
+
+bool VulkanReplay::HasPostVSDiskCache(uint32_t eventId)
+{
+  if(!m_PostVS.Replacements.empty())
+    return false;
+
+  if(!m_PostVS.DiskCacheLoaded)
+  {
+    m_PostVS.DiskCacheLoaded = true;
+    m_PostVS.DiskCacheFilename =
+        StringFormat::Fmt("vkpostvs_%08x.cache", m_pDriver->m_CaptureCacheHash);
+
+    bool success = LoadShaderCache(m_PostVS.DiskCacheFilename.c_str(), PostVSDiskCacheMagic,
+                                   PostVSDiskCacheVersion, m_PostVS.DiskCache,
+                                   VulkanPostVSCacheCallbacks);
+
+    // a partially read cache could contain anything, start again
+    if(!success)
+    {
+      for(auto it = m_PostVS.DiskCache.begin(); it != m_PostVS.DiskCache.end(); ++it)
+        VulkanPostVSCacheCallbacks.Destroy(it->second);
+      m_PostVS.DiskCache.clear();
+    }
+
+    for(auto it = m_PostVS.DiskCache.begin(); it != m_PostVS.DiskCache.end(); ++it)
+      m_PostVS.DiskCacheSize += it->second->size();
+  }
+
+  return m_PostVS.DiskCache.find(eventId) != m_PostVS.DiskCache.end();
+}
+
+bool VulkanReplay::LoadPostVSFromDiskCache(uint32_t eventId)
+{
+  if(!HasPostVSDiskCache(eventId))
+    return false;
+
+  const bytebuf &blob = *m_PostVS.DiskCache[eventId];
+
+  PostVSDiskCacheEntry entry;
+  memcpy(&entry, blob.data(), sizeof(entry));
+
+  if(sizeof(entry) + entry.vertexSize + entry.indexSize != blob.size() || entry.vertexSize == 0)
+  {
+    RDCERR("Invalid post-VS cache entry for event %u", eventId);
+    return false;
+  }
+
+  const byte *vertexData = blob.data() + sizeof(entry);
+  const byte *indexData = vertexData + entry.vertexSize;
+
+  VulkanPostVSData::StageData &vsout = m_PostVS.Data[eventId].vsout;
+
+  m_PostVS.Data[eventId].vsin.topo = entry.topo;
+
+  // usage flags must match those of buffers fetched directly
+  if(!CreateFilledBuffer(m_pDriver,
+                         VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                         vertexData, entry.vertexSize, vsout.buf, vsout.bufmem))
+    return true;
+
+  if(entry.indexSize > 0)
+  {
+    VkBufferUsageFlags idxUsage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    CreateFilledBuffer(m_pDriver, idxUsage, indexData, entry.indexSize, vsout.idxbuf,
+                       vsout.idxbufmem);
+  }
+
+  vsout.topo = entry.topo;
+  vsout.baseVertex = 0;
+  vsout.numVerts = entry.numVerts;
+  vsout.vertStride = entry.vertStride;
+  vsout.instStride = entry.instStride;
+  vsout.numViews = entry.numViews;
+  vsout.useIndices = entry.useIndices != 0;
+  vsout.idxFmt = entry.idxFmt;
+  vsout.hasPosOut = entry.hasPosOut != 0;
+  vsout.nearPlane = entry.nearPlane;
+  vsout.farPlane = entry.farPlane;
+
+  return true;
+}
+
+void VulkanReplay::AddPostVSToDiskCache(uint32_t eventId, const byte *vertexData,
+                                        uint64_t vertexSize, const bytebuf &indexData)
+{
+  if(vertexData == NULL || HasPostVSDiskCache(eventId) || !m_PostVS.Replacements.empty())
+    return;
+
+  uint64_t size = sizeof(PostVSDiskCacheEntry) + vertexSize + indexData.size();
+
+  if(m_PostVS.DiskCacheSize + size > PostVSDiskCacheMaxSize)
+    return;
+
+  const VulkanPostVSData::StageData &vsout = m_PostVS.Data[eventId].vsout;
+
+  PostVSDiskCacheEntry entry = {};
+  entry.topo = vsout.topo;
+  entry.numVerts = vsout.numVerts;
+  entry.vertStride = vsout.vertStride;
+  entry.instStride = vsout.instStride;
+  entry.numViews = vsout.numViews;
+  entry.useIndices = vsout.useIndices ? 1 : 0;
+  entry.idxFmt = vsout.idxFmt;
+  entry.hasPosOut = vsout.hasPosOut ? 1 : 0;
+  entry.nearPlane = vsout.nearPlane;
+  entry.farPlane = vsout.farPlane;
+  entry.vertexSize = vertexSize;
+  entry.indexSize = indexData.size();
+
+  bytebuf *blob = new bytebuf();
+  blob->resize((size_t)size);
+  memcpy(blob->data(), &entry, sizeof(entry));
+  memcpy(blob->data() + sizeof(entry), vertexData, (size_t)vertexSize);
+  if(!indexData.empty())
+    memcpy(blob->data() + sizeof(entry) + vertexSize, indexData.data(), indexData.size());
+
+  m_PostVS.DiskCache[eventId] = blob;
+  m_PostVS.DiskCacheSize += size;
+  m_PostVS.DiskCacheDirty = true;
+}
+
+void VulkanReplay::SavePostVSDiskCache()
+{
+  if(m_PostVS.DiskCacheDirty)
+  {
+    SaveShaderCache(m_PostVS.DiskCacheFilename.c_str(), PostVSDiskCacheMagic,
+                    PostVSDiskCacheVersion, m_PostVS.DiskCache, VulkanPostVSCacheCallbacks);
+  }
+  else
+  {
+    for(auto it = m_PostVS.DiskCache.begin(); it != m_PostVS.DiskCache.end(); ++it)
+      VulkanPostVSCacheCallbacks.Destroy(it->second);
+  }
+
+  m_PostVS.DiskCache.clear();
+  m_PostVS.DiskCacheSize = 0;
+  m_PostVS.DiskCacheLoaded = false;
+  m_PostVS.DiskCacheDirty = false;
 }
 
 void VulkanReplay::PatchReservedDescriptors(const VulkanStatePipeline &pipe,
@@ -1599,6 +1873,9 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
   VkBuffer rebasedIdxBuf = VK_NULL_HANDLE;
   VkDeviceMemory rebasedIdxBufMem = VK_NULL_HANDLE;
 
+  // kept for the disk cache
+  bytebuf rebasedIdxData;
+
   uint32_t numVerts = drawcall->numIndices;
   VkDeviceSize bufSize = 0;
 
@@ -1883,10 +2160,12 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
     RDCASSERTEQUAL(vkr, VK_SUCCESS);
 
     m_pDriver->vkUnmapMemory(m_Device, rebasedIdxBufMem);
+
+    if(state.ibuffer.buf != ResourceId())
+      rebasedIdxData.swap(idxdata);
   }
 
   uint32_t bufStride = 0;
-  std::vector<uint32_t> modSpirv = moduleInfo.spirv.GetSPIRV();
 
   struct CompactedAttrBuffer
   {
@@ -2254,25 +2533,52 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
     m_pDriver->vkUpdateDescriptorSets(dev, numWrites, descWrites, 0, NULL);
   }
 
-  ConvertToMeshOutputCompute(*refl, *pipeInfo.shaders[0].patchData,
-                             pipeInfo.shaders[0].entryPoint.c_str(), attrInstDivisor, drawcall,
-                             numVerts, numViews, modSpirv, bufStride);
+  PostVS::PatchedShaderKey shaderKey;
+  shaderKey.module = pipeInfo.shaders[0].module;
+  shaderKey.entryPoint = pipeInfo.shaders[0].entryPoint;
+  shaderKey.instDivisor = attrInstDivisor;
+  shaderKey.indexed = bool(drawcall->flags & DrawFlags::Indexed);
+  shaderKey.numVerts = numVerts;
+  shaderKey.numInstances = drawcall->numInstances;
+  shaderKey.numViews = numViews;
+  shaderKey.vertexOffset = drawcall->vertexOffset;
+  shaderKey.instanceOffset = drawcall->instanceOffset;
+  shaderKey.drawIndex = drawcall->drawIndex;
+  shaderKey.baseVertex = drawcall->baseVertex;
+
+  VkShaderModule module = VK_NULL_HANDLE;
+
+  auto patchedIt = m_PostVS.PatchedShaders.find(shaderKey);
+  if(patchedIt != m_PostVS.PatchedShaders.end())
+  {
+    module = patchedIt->second.module;
+    bufStride = patchedIt->second.bufStride;
+  }
+  else
+  {
+    std::vector<uint32_t> modSpirv = moduleInfo.GetReflector().GetSPIRV();
+
+    ConvertToMeshOutputCompute(*refl, *pipeInfo.shaders[0].patchData,
+                               pipeInfo.shaders[0].entryPoint.c_str(), attrInstDivisor, drawcall,
+                               numVerts, numViews, modSpirv, bufStride);
+
+    // create vertex shader with modified code
+    VkShaderModuleCreateInfo moduleCreateInfo = {
+        VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO, NULL,         0,
+        modSpirv.size() * sizeof(uint32_t),          &modSpirv[0],
+    };
+
+    vkr = m_pDriver->vkCreateShaderModule(dev, &moduleCreateInfo, NULL, &module);
+    RDCASSERTEQUAL(vkr, VK_SUCCESS);
+
+    m_PostVS.PatchedShaders[shaderKey] = {module, bufStride};
+  }
 
   VkComputePipelineCreateInfo compPipeInfo = {VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
 
   // repoint pipeline layout
   compPipeInfo.layout = pipeLayout;
 
-  // create vertex shader with modified code
-  VkShaderModuleCreateInfo moduleCreateInfo = {
-      VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO, NULL,         0,
-      modSpirv.size() * sizeof(uint32_t),          &modSpirv[0],
-  };
-
-  VkShaderModule module;
-  vkr = m_pDriver->vkCreateShaderModule(dev, &moduleCreateInfo, NULL, &module);
-  RDCASSERTEQUAL(vkr, VK_SUCCESS);
-
   compPipeInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
   compPipeInfo.stage.module = module;
   compPipeInfo.stage.pName = PatchedMeshOutputEntryPoint;
@@ -2290,7 +2596,9 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
 
   // create new pipeline
   VkPipeline pipe;
-  vkr = m_pDriver->vkCreateComputePipelines(m_Device, VK_NULL_HANDLE, 1, &compPipeInfo, NULL, &pipe);
+  VkPipelineCache pipeCache = m_pDriver->GetShaderCache()->GetPipelineCache();
+
+  vkr = m_pDriver->vkCreateComputePipelines(m_Device, pipeCache, 1, &compPipeInfo, NULL, &pipe);
 
   if(vkr != VK_SUCCESS)
   {
@@ -2549,19 +2857,6 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
     farp = FLT_MAX;
   }
 
-  m_pDriver->vkUnmapMemory(m_Device, readbackMem);
-
-  // clean up temporary memories
-  m_pDriver->vkDestroyBuffer(m_Device, readbackBuffer, NULL);
-  m_pDriver->vkFreeMemory(m_Device, readbackMem, NULL);
-
-  if(uniqIdxBuf != VK_NULL_HANDLE)
-  {
-    m_pDriver->vkDestroyBuffer(m_Device, uniqIdxBuf, NULL);
-    m_pDriver->vkFreeMemory(m_Device, uniqIdxBufMem, NULL);
-    m_pDriver->vkDestroyBufferView(m_Device, uniqIdxBufView, NULL);
-  }
-
   // fill out m_PostVS.Data
   m_PostVS.Data[eventId].vsin.topo = pipeCreateInfo.pInputAssemblyState->topology;
   m_PostVS.Data[eventId].vsout.topo = pipeCreateInfo.pInputAssemblyState->topology;
@@ -2600,6 +2895,21 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
   m_PostVS.Data[eventId].vsout.hasPosOut =
       refl->outputSignature[0].systemValue == ShaderBuiltin::Position;
 
+  AddPostVSToDiskCache(eventId, byteData, bufSize, rebasedIdxData);
+
+  m_pDriver->vkUnmapMemory(m_Device, readbackMem);
+
+  // clean up temporary memories
+  m_pDriver->vkDestroyBuffer(m_Device, readbackBuffer, NULL);
+  m_pDriver->vkFreeMemory(m_Device, readbackMem, NULL);
+
+  if(uniqIdxBuf != VK_NULL_HANDLE)
+  {
+    m_pDriver->vkDestroyBuffer(m_Device, uniqIdxBuf, NULL);
+    m_pDriver->vkFreeMemory(m_Device, uniqIdxBufMem, NULL);
+    m_pDriver->vkDestroyBufferView(m_Device, uniqIdxBufView, NULL);
+  }
+
   // delete descriptors. Technically we don't have to free the descriptor sets, but our tracking on
   // replay doesn't handle destroying children of pooled objects so we do it explicitly anyway.
   m_pDriver->vkFreeDescriptorSets(dev, descpool, (uint32_t)descSets.size(), descSets.data());
@@ -2612,11 +2922,8 @@ void VulkanReplay::FetchVSOut(uint32_t eventId)
   for(VkDescriptorSetLayout layout : setLayouts)
     m_pDriver->vkDestroyDescriptorSetLayout(dev, layout, NULL);
 
-  // delete pipeline
+  // delete pipeline. The shader module is kept in the patched shader cache
   m_pDriver->vkDestroyPipeline(dev, pipe, NULL);
-
-  // delete shader/shader module
-  m_pDriver->vkDestroyShaderModule(dev, module, NULL);
 }
 
 void VulkanReplay::FetchTessGSOut(uint32_t eventId)
@@ -2717,7 +3024,7 @@ void VulkanReplay::FetchTessGSOut(uint32_t eventId)
   const VulkanCreationInfo::ShaderModule &moduleInfo =
       creationInfo.m_ShaderModule[pipeInfo.shaders[stageIndex].module];
 
-  std::vector<uint32_t> modSpirv = moduleInfo.spirv.GetSPIRV();
+  std::vector<uint32_t> modSpirv = moduleInfo.GetReflector().GetSPIRV();
 
   uint32_t xfbStride = 0;
 
@@ -3189,11 +3496,14 @@ void VulkanReplay::InitPostVSBuffers(uint32_t eventId)
   if(drawcall == NULL || drawcall->numIndices == 0 || drawcall->numInstances == 0)
     return;
 
-  VkMarkerRegion::Begin(StringFormat::Fmt("FetchVSOut for %u", eventId));
+  if(!LoadPostVSFromDiskCache(eventId))
+  {
+    VkMarkerRegion::Begin(StringFormat::Fmt("FetchVSOut for %u", eventId));
 
-  FetchVSOut(eventId);
+    FetchVSOut(eventId);
 
-  VkMarkerRegion::End();
+    VkMarkerRegion::End();
+  }
 
   // if there's no tessellation or geometry shader active, bail out now
   if(pipeInfo.shaders[2].module == ResourceId() && pipeInfo.shaders[3].module == ResourceId())
@@ -3211,12 +3521,14 @@ struct VulkanInitPostVSCallback : public VulkanDrawcallCallback
   VulkanInitPostVSCallback(WrappedVulkan *vk, const std::vector<uint32_t> &events)
       : m_pDriver(vk), m_Events(events)
   {
+    // sorted for lookup, large batches can contain thousands of draws
+    std::sort(m_Events.begin(), m_Events.end());
     m_pDriver->SetDrawcallCB(this);
   }
   ~VulkanInitPostVSCallback() { m_pDriver->SetDrawcallCB(NULL); }
   void PreDraw(uint32_t eid, VkCommandBuffer cmd)
   {
-    if(std::find(m_Events.begin(), m_Events.end(), eid) != m_Events.end())
+    if(std::binary_search(m_Events.begin(), m_Events.end(), eid))
       m_pDriver->GetReplay()->InitPostVSBuffers(eid);
   }
 
@@ -3233,16 +3545,37 @@ struct VulkanInitPostVSCallback : public VulkanDrawcallCallback
   void PreEndCommandBuffer(VkCommandBuffer cmd) {}
   void AliasEvent(uint32_t primary, uint32_t alias)
   {
-    if(std::find(m_Events.begin(), m_Events.end(), primary) != m_Events.end())
+    if(std::binary_search(m_Events.begin(), m_Events.end(), primary))
       m_pDriver->GetReplay()->AliasPostVSBuffers(primary, alias);
   }
 
   WrappedVulkan *m_pDriver;
-  const std::vector<uint32_t> &m_Events;
+  std::vector<uint32_t> m_Events;
 };
 
 void VulkanReplay::InitPostVSBuffers(const std::vector<uint32_t> &events)
 {
+  // don't replay at all if every draw already has its data
+  bool needReplay = false;
+  for(uint32_t eid : events)
+  {
+    uint32_t id = eid;
+    if(m_PostVS.Alias.find(id) != m_PostVS.Alias.end())
+      id = m_PostVS.Alias[id];
+
+    const DrawcallDescription *drawcall = m_pDriver->GetDrawcall(id);
+
+    if(drawcall && (drawcall->flags & DrawFlags::Drawcall) &&
+       m_PostVS.Data.find(id) == m_PostVS.Data.end())
+    {
+      needReplay = true;
+      break;
+    }
+  }
+
+  if(!needReplay)
+    return;
+
   // first we must replay up to the first event without replaying it. This ensures any
   // non-command buffer calls like memory unmaps etc all happen correctly before this
   // command buffer
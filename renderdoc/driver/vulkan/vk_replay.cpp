@@ -52,6 +52,7 @@ VulkanReplay::VulkanReplay()
   m_Proxy = false;
 
   m_HighlightCache.driver = this;
+  m_PickCache.driver = this;
 
   m_OutputWinID = 1;
   m_ActiveWinID = 0;
@@ -174,6 +175,11 @@ rdcarray<GPUDevice> VulkanReplay::GetAvailableGPUs()
   return ret;
 }
 
+InitialStateRestoreStats VulkanReplay::GetInitialStateRestoreStats()
+{
+  return m_pDriver->GetResourceManager()->GetInitialStateRestoreStats();
+}
+
 APIProperties VulkanReplay::GetAPIProperties()
 {
   APIProperties ret = m_pDriver->APIProps;
@@ -189,7 +195,14 @@ APIProperties VulkanReplay::GetAPIProperties()
 
 ReplayStatus VulkanReplay::ReadLogInitialisation(RDCFile *rdc, bool storeStructuredBuffers)
 {
-  return m_pDriver->ReadLogInitialisation(rdc, storeStructuredBuffers);
+  ReplayStatus status = m_pDriver->ReadLogInitialisation(rdc, storeStructuredBuffers);
+
+  // now that the capture section is no longer being read, persist any shader reflection that had to
+  // be computed so that it can be loaded next time.
+  if(status == ReplayStatus::Succeeded)
+    m_pDriver->SaveReflectionCache(rdc);
+
+  return status;
 }
 
 void VulkanReplay::ReplayLog(uint32_t endEventID, ReplayLogType replayType)
@@ -414,12 +427,14 @@ rdcarray<ShaderEntryPoint> VulkanReplay::GetShaderEntryPoints(ResourceId shader)
   if(shad == m_pDriver->m_CreationInfo.m_ShaderModule.end())
     return {};
 
-  std::vector<std::string> entries = shad->second.spirv.EntryPoints();
+  const rdcspv::Reflector &spirv = shad->second.GetReflector();
+
+  std::vector<std::string> entries = spirv.EntryPoints();
 
   rdcarray<ShaderEntryPoint> ret;
 
   for(const std::string &e : entries)
-    ret.push_back({e, shad->second.spirv.StageForEntry(e)});
+    ret.push_back({e, spirv.StageForEntry(e)});
 
   return ret;
 }
@@ -438,7 +453,8 @@ ShaderReflection *VulkanReplay::GetShader(ResourceId pipeline, ResourceId shader
   // if this shader was never used in a pipeline the reflection won't be prepared. Do that now -
   // this will be ignored if it was already prepared.
   shad->second.GetReflection(entry.name, pipeline)
-      .Init(GetResourceManager(), shader, shad->second.spirv, entry.name,
+      .Init(GetResourceManager(), m_pDriver->m_CreationInfo, shader,
+            VulkanCreationInfo::ShaderModuleReflectionKey(entry.name, ResourceId()),
             VkShaderStageFlagBits(1 << uint32_t(entry.stage)), {});
 
   return &shad->second.GetReflection(entry.name, pipeline).refl;
@@ -550,7 +566,7 @@ std::string VulkanReplay::DisassembleShader(ResourceId pipeline, const ShaderRef
     std::string &disasm = it->second.GetReflection(refl->entryPoint, pipeline).disassembly;
 
     if(disasm.empty())
-      disasm = it->second.spirv.Disassemble(refl->entryPoint.c_str());
+      disasm = it->second.GetReflector().Disassemble(refl->entryPoint.c_str());
 
     return disasm;
   }
@@ -3943,6 +3959,9 @@ void VulkanReplay::ReplaceResource(ResourceId from, ResourceId to)
   // now update any derived resources
   RefreshDerivedReplacements();
 
+  // post-VS data on disk only reflects the original shaders
+  m_PostVS.Replacements.insert(from);
+
   ClearPostVSCache();
   ClearFeedbackCache();
 }
@@ -3955,6 +3974,8 @@ void VulkanReplay::RemoveReplacement(ResourceId id)
 
     RefreshDerivedReplacements();
 
+    m_PostVS.Replacements.erase(id);
+
     ClearPostVSCache();
     ClearFeedbackCache();
   }
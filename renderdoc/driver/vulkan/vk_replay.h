@@ -252,6 +252,7 @@ public:
   void SetDriver(WrappedVulkan *d) { m_pDriver = d; }
   DriverInformation GetDriverInfo() { return m_DriverInfo; }
   rdcarray<GPUDevice> GetAvailableGPUs();
+  InitialStateRestoreStats GetInitialStateRestoreStats();
   APIProperties GetAPIProperties();
 
   ResourceDescription &GetResourceDesc(ResourceId id);
@@ -421,6 +422,11 @@ private:
   void FetchVSOut(uint32_t eventId);
   void FetchTessGSOut(uint32_t eventId);
   void ClearPostVSCache();
+  bool HasPostVSDiskCache(uint32_t eventId);
+  bool LoadPostVSFromDiskCache(uint32_t eventId);
+  void AddPostVSToDiskCache(uint32_t eventId, const byte *vertexData, uint64_t vertexSize,
+                            const bytebuf &indexData);
+  void SavePostVSDiskCache();
 
   void RefreshDerivedReplacements();
 
@@ -490,6 +496,7 @@ private:
   uint32_t m_DebugWidth, m_DebugHeight;
 
   HighlightCache m_HighlightCache;
+  MeshPickCache m_PickCache;
 
   bool m_Proxy;
 
@@ -682,6 +689,40 @@ private:
 
     std::map<uint32_t, VulkanPostVSData> Data;
     std::map<uint32_t, uint32_t> Alias;
+
+    // the patched compute shader only depends on the vertex shader and the draw parameters baked
+    // into it, so it can be shared between draws e.g. when the same mesh is drawn repeatedly.
+    struct PatchedShaderKey
+    {
+      ResourceId module;
+      std::string entryPoint;
+      std::vector<uint32_t> instDivisor;
+      bool indexed;
+      uint32_t numVerts, numInstances, numViews;
+      uint32_t vertexOffset, instanceOffset, drawIndex;
+      int32_t baseVertex;
+
+      bool operator<(const PatchedShaderKey &o) const;
+    };
+
+    struct PatchedShader
+    {
+      VkShaderModule module;
+      uint32_t bufStride;
+    };
+
+    std::map<PatchedShaderKey, PatchedShader> PatchedShaders;
+
+    // vertex output is also stored on disk per capture, so that it doesn't have to be fetched
+    // again in later sessions. Entries are loaded and saved as a whole, keyed by event ID.
+    std::string DiskCacheFilename;
+    std::map<uint32_t, bytebuf *> DiskCache;
+    uint64_t DiskCacheSize = 0;
+    bool DiskCacheLoaded = false;
+    bool DiskCacheDirty = false;
+
+    // the disk cache is only valid for the original shaders, so is ignored while any are replaced
+    std::set<ResourceId> Replacements;
   } m_PostVS;
 
   struct Feedback
@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "vk_common.h"
+#include "vk_info.h"
 #include "vk_manager.h"
 #include "vk_resources.h"
 
@@ -3571,6 +3572,24 @@ void DoSerialise(SerialiserType &ser, DescriptorSetSlot &el)
   SERIALISE_MEMBER(texelBufferView).TypedAs("VkBufferView"_lit);
 }
 
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, VulkanCreationInfo::ReflectionCacheKey &el)
+{
+  SERIALISE_MEMBER(spirvHash);
+  SERIALISE_MEMBER(stageIndex);
+  SERIALISE_MEMBER(entryPoint);
+  SERIALISE_MEMBER(specInfo);
+}
+
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, VulkanCreationInfo::ReflectionCacheEntry &el)
+{
+  SERIALISE_MEMBER(key);
+  SERIALISE_MEMBER(refl);
+  SERIALISE_MEMBER(mapping);
+  SERIALISE_MEMBER(patchData);
+}
+
 template <typename SerialiserType>
 void DoSerialise(SerialiserType &ser, ImageRegionState &el)
 {
@@ -7690,6 +7709,8 @@ INSTANTIATE_SERIALISE_TYPE(VkViewport);
 INSTANTIATE_SERIALISE_TYPE(VkXYColorEXT);
 
 INSTANTIATE_SERIALISE_TYPE(DescriptorSetSlot);
+INSTANTIATE_SERIALISE_TYPE(VulkanCreationInfo::ReflectionCacheKey);
+INSTANTIATE_SERIALISE_TYPE(VulkanCreationInfo::ReflectionCacheEntry);
 INSTANTIATE_SERIALISE_TYPE(ImageRegionState);
 INSTANTIATE_SERIALISE_TYPE(ImageLayouts);
 INSTANTIATE_SERIALISE_TYPE(ImageInfo);
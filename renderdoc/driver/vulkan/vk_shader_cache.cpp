@@ -225,6 +225,90 @@ VulkanShaderCache::~VulkanShaderCache()
 
   for(size_t i = 0; i < ARRAY_COUNT(m_BuiltinShaderModules); i++)
     m_pDriver->vkDestroyShaderModule(m_Device, m_BuiltinShaderModules[i], NULL);
+
+  if(m_PipelineCache != VK_NULL_HANDLE)
+  {
+    size_t size = 0;
+    VkResult vkr = ObjDisp(m_Device)->GetPipelineCacheData(Unwrap(m_Device),
+                                                           Unwrap(m_PipelineCache), &size, NULL);
+
+    // only write the cache back if compiling added anything to it
+    if(vkr == VK_SUCCESS && size > m_PipelineCacheLoadedSize)
+    {
+      std::vector<byte> data(size);
+      vkr = ObjDisp(m_Device)->GetPipelineCacheData(Unwrap(m_Device), Unwrap(m_PipelineCache),
+                                                    &size, data.data());
+
+      FILE *f = vkr == VK_SUCCESS ? FileIO::fopen(m_PipelineCacheFilename.c_str(), "wb") : NULL;
+
+      if(f)
+      {
+        FileIO::fwrite(data.data(), 1, size, f);
+        FileIO::fclose(f);
+
+        RDCDEBUG("Wrote %llu bytes to pipeline cache %s", (uint64_t)size,
+                 m_PipelineCacheFilename.c_str());
+      }
+      else
+      {
+        RDCWARN("Couldn't write pipeline cache %s", m_PipelineCacheFilename.c_str());
+      }
+    }
+
+    m_pDriver->vkDestroyPipelineCache(m_Device, m_PipelineCache, NULL);
+  }
+}
+
+void VulkanShaderCache::LoadPipelineCache(const std::string &filename)
+{
+  RDCASSERT(m_PipelineCache == VK_NULL_HANDLE);
+
+  m_PipelineCacheFilename = FileIO::GetAppFolderFilename(filename);
+
+  std::vector<byte> data;
+
+  FILE *f = FileIO::fopen(m_PipelineCacheFilename.c_str(), "rb");
+
+  if(f)
+  {
+    FileIO::fseek64(f, 0, SEEK_END);
+    data.resize((size_t)FileIO::ftell64(f));
+    FileIO::fseek64(f, 0, SEEK_SET);
+    if(FileIO::fread(data.data(), 1, data.size(), f) != data.size())
+      data.clear();
+    FileIO::fclose(f);
+  }
+
+  // the driver validates the header against its own vendor, device and cache UUID and ignores data
+  // from anywhere else, so a stale file just means starting with an empty cache.
+  VkPipelineCacheCreateInfo info = {
+      VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO, NULL, 0, data.size(), data.data(),
+  };
+
+  VkResult vkr = m_pDriver->vkCreatePipelineCache(m_Device, &info, NULL, &m_PipelineCache);
+
+  if(vkr != VK_SUCCESS && !data.empty())
+  {
+    RDCWARN("Couldn't create pipeline cache from %s, starting empty",
+            m_PipelineCacheFilename.c_str());
+    info.initialDataSize = 0;
+    info.pInitialData = NULL;
+    vkr = m_pDriver->vkCreatePipelineCache(m_Device, &info, NULL, &m_PipelineCache);
+  }
+
+  if(vkr != VK_SUCCESS)
+  {
+    RDCERR("Failed to create replay pipeline cache, VkResult: %s", ToStr(vkr).c_str());
+    m_PipelineCache = VK_NULL_HANDLE;
+    return;
+  }
+
+  m_PipelineCacheLoadedSize = info.initialDataSize;
+
+  m_pDriver->GetResourceManager()->SetInternalResource(GetResID(m_PipelineCache));
+
+  RDCDEBUG("Loaded %llu bytes of pipeline cache from %s", (uint64_t)info.initialDataSize,
+           m_PipelineCacheFilename.c_str());
 }
 
 std::string VulkanShaderCache::GetSPIRVBlob(const rdcspv::CompilationSettings &settings,
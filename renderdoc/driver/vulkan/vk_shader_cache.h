@@ -77,6 +77,10 @@ public:
 
   std::string GetGlobalDefines() { return m_GlobalDefines; }
   void SetCaching(bool enabled) { m_CacheShaders = enabled; }
+  // creates the pipeline cache used when replaying the capture's pipelines, seeded from the given
+  // file if a previous load of the same capture saved it. The data is written back on shutdown.
+  void LoadPipelineCache(const std::string &filename);
+  VkPipelineCache GetPipelineCache() { return m_PipelineCache; }
 private:
   static const uint32_t m_ShaderCacheMagic = 0xf00d00d5;
   static const uint32_t m_ShaderCacheVersion = 1;
@@ -89,6 +93,10 @@ private:
   bool m_ShaderCacheDirty = false, m_CacheShaders = false;
   std::map<uint32_t, SPIRVBlob> m_ShaderCache;
 
+  std::string m_PipelineCacheFilename;
+  size_t m_PipelineCacheLoadedSize = 0;
+  VkPipelineCache m_PipelineCache = VK_NULL_HANDLE;
+
   SPIRVBlob m_BuiltinShaderBlobs[arraydim<BuiltinShader>()] = {NULL};
   VkShaderModule m_BuiltinShaderModules[arraydim<BuiltinShader>()] = {VK_NULL_HANDLE};
 };
@@ -1240,6 +1240,10 @@ bool WrappedVulkan::Serialise_vkCmdBeginRenderPass(SerialiserType &ser, VkComman
         ResourceId cmd = GetResID(commandBuffer);
         GetResourceManager()->RecordBarriers(m_BakedCmdBufferInfo[cmd].imgbarriers, m_ImageLayouts,
                                              (uint32_t)imgBarriers.size(), imgBarriers.data());
+
+        // attachments can be written by load and store ops even with no draws in the pass
+        for(ResourceId view : m_BakedCmdBufferInfo[m_LastCmdBufferID].state.fbattachments)
+          MarkInitialContentsWritten(m_CreationInfo.m_ImageView[view].image);
       }
     }
     else
@@ -1656,6 +1660,10 @@ bool WrappedVulkan::Serialise_vkCmdBeginRenderPass2KHR(SerialiserType &ser,
         ResourceId cmd = GetResID(commandBuffer);
         GetResourceManager()->RecordBarriers(m_BakedCmdBufferInfo[cmd].imgbarriers, m_ImageLayouts,
                                              (uint32_t)imgBarriers.size(), imgBarriers.data());
+
+        // attachments can be written by load and store ops even with no draws in the pass
+        for(ResourceId view : m_BakedCmdBufferInfo[m_LastCmdBufferID].state.fbattachments)
+          MarkInitialContentsWritten(m_CreationInfo.m_ImageView[view].image);
       }
     }
     else
@@ -2532,6 +2540,9 @@ bool WrappedVulkan::Serialise_vkCmdUpdateBuffer(SerialiserType &ser, VkCommandBu
     {
       ObjDisp(commandBuffer)
           ->CmdUpdateBuffer(Unwrap(commandBuffer), Unwrap(destBuffer), destOffset, dataSize, Data);
+
+      if(IsActiveReplaying(m_State))
+        MarkInitialContentsWritten(GetResID(destBuffer));
     }
   }
 
@@ -2595,6 +2606,9 @@ bool WrappedVulkan::Serialise_vkCmdFillBuffer(SerialiserType &ser, VkCommandBuff
     {
       ObjDisp(commandBuffer)
           ->CmdFillBuffer(Unwrap(commandBuffer), Unwrap(destBuffer), destOffset, fillSize, data);
+
+      if(IsActiveReplaying(m_State))
+        MarkInitialContentsWritten(GetResID(destBuffer));
     }
   }
 
@@ -2963,6 +2977,9 @@ bool WrappedVulkan::Serialise_vkCmdCopyQueryPoolResults(
       ObjDisp(commandBuffer)
           ->CmdCopyQueryPoolResults(Unwrap(commandBuffer), Unwrap(queryPool), firstQuery,
                                     queryCount, Unwrap(destBuffer), destOffset, destStride, flags);
+
+      if(IsActiveReplaying(m_State))
+        MarkInitialContentsWritten(GetResID(destBuffer));
     }
   }
 
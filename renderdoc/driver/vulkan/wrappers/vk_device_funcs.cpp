@@ -2652,6 +2652,9 @@ bool WrappedVulkan::Serialise_vkCreateDevice(SerialiserType &ser, VkPhysicalDevi
 
     m_ShaderCache = new VulkanShaderCache(this);
 
+    if(!m_PipelineCacheFilename.empty())
+      m_ShaderCache->LoadPipelineCache(m_PipelineCacheFilename);
+
     m_DebugManager = new VulkanDebugManager(this);
 
     m_Replay.CreateResources();
@@ -609,8 +609,13 @@ bool WrappedVulkan::Serialise_vkUnmapMemory(SerialiserType &ser, VkDevice device
   ser.Serialise("MapData"_lit, MapData, MapSize, SerialiserFlags::NoFlags);
 
   if(IsReplayingAndReading() && MapData && memory != VK_NULL_HANDLE)
+  {
     ObjDisp(device)->UnmapMemory(Unwrap(device), Unwrap(memory));
 
+    if(IsActiveReplaying(m_State))
+      MarkInitialContentsWritten(GetResID(memory));
+  }
+
   SERIALISE_CHECK_READ_ERRORS();
 
   return true;
@@ -735,8 +740,13 @@ bool WrappedVulkan::Serialise_vkFlushMappedMemoryRanges(SerialiserType &ser, VkD
   ser.Serialise("MappedData"_lit, MappedData, memRangeSize, SerialiserFlags::NoFlags);
 
   if(IsReplayingAndReading() && MappedData && MemRange.memory != VK_NULL_HANDLE)
+  {
     ObjDisp(device)->UnmapMemory(Unwrap(device), Unwrap(MemRange.memory));
 
+    if(IsActiveReplaying(m_State))
+      MarkInitialContentsWritten(GetResID(MemRange.memory));
+  }
+
   SERIALISE_CHECK_READ_ERRORS();
 
   // if we need to save off this serialised buffer as reference for future comparison,
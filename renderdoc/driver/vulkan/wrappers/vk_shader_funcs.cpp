@@ -23,6 +23,7 @@
  ******************************************************************************/
 
 #include "../vk_core.h"
+#include "../vk_shader_cache.h"
 #include "driver/shaders/spirv/spirv_reflect.h"
 
 template <>
@@ -418,8 +419,9 @@ bool WrappedVulkan::Serialise_vkCreateGraphicsPipelines(
     VkRenderPass origRP = CreateInfo.renderPass;
     VkPipelineCache origCache = pipelineCache;
 
-    // don't use pipeline caches on replay
-    pipelineCache = VK_NULL_HANDLE;
+    // don't use the application's pipeline caches on replay, instead use our own which is
+    // persisted per-capture so that loading the same capture again skips most of the compilation
+    pipelineCache = m_ShaderCache ? m_ShaderCache->GetPipelineCache() : VK_NULL_HANDLE;
 
     // if we have pipeline executable properties, capture the data
     if(GetExtensions(NULL).ext_KHR_pipeline_executable_properties)
@@ -619,8 +621,9 @@ bool WrappedVulkan::Serialise_vkCreateComputePipelines(SerialiserType &ser, VkDe
 
     VkPipelineCache origCache = pipelineCache;
 
-    // don't use pipeline caches on replay
-    pipelineCache = VK_NULL_HANDLE;
+    // don't use the application's pipeline caches on replay, instead use our own which is
+    // persisted per-capture so that loading the same capture again skips most of the compilation
+    pipelineCache = m_ShaderCache ? m_ShaderCache->GetPipelineCache() : VK_NULL_HANDLE;
 
     // if we have pipeline executable properties, capture the data
     if(GetExtensions(NULL).ext_KHR_pipeline_executable_properties)
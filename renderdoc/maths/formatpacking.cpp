@@ -147,6 +147,7 @@ uint32_t ConvertToR11G11B10(Vec3f data)
 #undef None
 
 #include "3rdparty/catch/catch.hpp"
+#include "common/benchmark.h"
 
 TEST_CASE("Check format conversion", "[format]")
 {
@@ -456,4 +457,63 @@ TEST_CASE("Check format conversion", "[format]")
   };
 }
 
+TEST_CASE("Benchmark format conversion", "[format][!benchmark]")
+{
+  // a 512x512 RGBA texture's worth of components
+  const size_t numTexels = 512 * 512;
+
+  std::vector<byte> data(numTexels * 4 * sizeof(float));
+  for(size_t i = 0; i < data.size(); i++)
+    data[i] = byte(i * 31 + (i >> 8));
+
+  // keep the floats finite so that no conversion takes a special-case path for every value
+  float *floats = (float *)data.data();
+  for(size_t i = 0; i < numTexels * 4; i++)
+    floats[i] = float(i % 1000) * 0.01f - 5.0f;
+
+  auto convert = [&](const char *name, CompType compType, uint8_t compByteWidth) {
+    ResourceFormat fmt;
+    fmt.type = ResourceFormatType::Regular;
+    fmt.compType = compType;
+    fmt.compByteWidth = compByteWidth;
+    fmt.compCount = 4;
+
+    const size_t bytes = numTexels * 4 * compByteWidth;
+
+    RunBenchmark(name, bytes, [&]() {
+      float sum = 0.0f;
+      for(size_t i = 0; i < bytes; i += compByteWidth)
+        sum += ConvertComponent(fmt, data.data() + i);
+      BenchmarkKeep(uint64_t(sum));
+    });
+  };
+
+  convert("ConvertComponent 512x512 RGBA8 UNorm", CompType::UNorm, 1);
+  convert("ConvertComponent 512x512 RGBA16 Float", CompType::Float, 2);
+  convert("ConvertComponent 512x512 RGBA32 Float", CompType::Float, 4);
+
+  RunBenchmark("ConvertToHalf 1M floats", numTexels * 4 * sizeof(float), [&]() {
+    uint64_t sum = 0;
+    for(size_t i = 0; i < numTexels * 4; i++)
+      sum += ConvertToHalf(floats[i]);
+    BenchmarkKeep(sum);
+  });
+
+  const uint32_t *packed = (const uint32_t *)data.data();
+
+  RunBenchmark("ConvertFromR11G11B10 512x512", numTexels * sizeof(uint32_t), [&]() {
+    float sum = 0.0f;
+    for(size_t i = 0; i < numTexels; i++)
+      sum += ConvertFromR11G11B10(packed[i]).x;
+    BenchmarkKeep(uint64_t(sum));
+  });
+
+  RunBenchmark("ConvertLinearToSRGB 1M floats", numTexels * 4 * sizeof(float), [&]() {
+    float sum = 0.0f;
+    for(size_t i = 0; i < numTexels * 4; i++)
+      sum += ConvertLinearToSRGB(floats[i]);
+    BenchmarkKeep(uint64_t(sum));
+  });
+}
+
 #endif
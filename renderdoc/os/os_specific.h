@@ -147,6 +147,9 @@ void DetachThread(ThreadHandle handle);
 void CloseThread(ThreadHandle handle);
 void Sleep(uint32_t milliseconds);
 
+// number of logical processors available, always at least 1
+uint32_t NumberOfCores();
+
 // kind of windows specific, to handle this case:
 // http://blogs.msdn.com/b/oldnewthing/archive/2013/11/05/10463645.aspx
 void KeepModuleAlive();
@@ -155,6 +158,25 @@ void ReleaseModuleExitThread();
 
 namespace Network
 {
+// a signal that can be raised from any thread to wake up another thread blocked in Socket::Wait
+class Wakeup
+{
+public:
+  Wakeup();
+  ~Wakeup();
+
+  void Signal();
+  void Reset();
+
+  // no copying
+  Wakeup &operator=(const Wakeup &other) = delete;
+  Wakeup(const Wakeup &other) = delete;
+
+private:
+  friend class Socket;
+  ptrdiff_t handle[2];
+};
+
 class Socket
 {
 public:
@@ -172,6 +194,11 @@ public:
 
   bool IsRecvDataWaiting();
 
+  // blocks until the socket is readable (data has arrived, a connection is pending on a server
+  // socket, or the connection closed), the wakeup is signalled, or the timeout expires. Returns
+  // true only if the socket became readable.
+  bool Wait(Wakeup *wakeup, uint32_t timeoutMilliseconds);
+
   bool SendDataBlocking(const void *buf, uint32_t length);
   bool RecvDataBlocking(void *data, uint32_t length);
   bool RecvDataNonBlocking(void *data, uint32_t &length);
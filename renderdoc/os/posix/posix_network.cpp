@@ -27,6 +27,7 @@
 #include <netdb.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
+#include <poll.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -80,6 +81,53 @@ void Shutdown()
 {
 }
 
+Wakeup::Wakeup()
+{
+  int fds[2] = {-1, -1};
+  if(pipe(fds) != 0)
+  {
+    RDCERR("Couldn't create wakeup pipe: %s", errno_string(errno).c_str());
+    fds[0] = fds[1] = -1;
+  }
+
+  for(int i = 0; i < 2; i++)
+  {
+    if(fds[i] != -1)
+    {
+      int flags = fcntl(fds[i], F_GETFL, 0);
+      fcntl(fds[i], F_SETFL, flags | O_NONBLOCK);
+      flags = fcntl(fds[i], F_GETFD, 0);
+      fcntl(fds[i], F_SETFD, flags | FD_CLOEXEC);
+    }
+
+    handle[i] = (ptrdiff_t)fds[i];
+  }
+}
+
+Wakeup::~Wakeup()
+{
+  for(int i = 0; i < 2; i++)
+    if((int)handle[i] != -1)
+      close((int)handle[i]);
+}
+
+void Wakeup::Signal()
+{
+  // if the pipe is full the waiter already has a pending wakeup, so failure is fine
+  char dummy = 0;
+  if((int)handle[1] != -1)
+    write((int)handle[1], &dummy, 1);
+}
+
+void Wakeup::Reset()
+{
+  char dummy[64];
+  if((int)handle[0] != -1)
+    while(read((int)handle[0], dummy, sizeof(dummy)) > 0)
+    {
+    }
+}
+
 Socket::~Socket()
 {
   Shutdown();
@@ -233,6 +281,33 @@ bool Socket::IsRecvDataWaiting()
   return ret > 0;
 }
 
+bool Socket::Wait(Wakeup *wakeup, uint32_t timeoutMilliseconds)
+{
+  pollfd fds[2] = {};
+  fds[0].fd = (int)socket;
+  fds[0].events = POLLIN;
+
+  nfds_t count = 1;
+  if(wakeup && (int)wakeup->handle[0] != -1)
+  {
+    fds[1].fd = (int)wakeup->handle[0];
+    fds[1].events = POLLIN;
+    count++;
+  }
+
+  int ret = poll(fds, count, (int)timeoutMilliseconds);
+
+  if(ret < 0)
+  {
+    int err = errno;
+    if(err != EINTR)
+      RDCWARN("poll: %s", errno_string(err).c_str());
+    return false;
+  }
+
+  return (fds[0].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+}
+
 bool Socket::RecvDataNonBlocking(void *buf, uint32_t &length)
 {
   if(length == 0)
@@ -174,9 +174,9 @@ static void *sThreadInit(void *init)
   return NULL;
 }
 
-// to not exhaust OS slots, we only allocate one that points
-// to our own array
-pthread_key_t OSTLSHandle;
+// slots are indices into a per-thread array, so we don't exhaust OS slots. The array is found
+// through a native thread_local pointer rather than an OS slot lookup, since GetTLSValue is called
+// on every captured API call.
 int64_t nextTLSSlot = 0;
 
 struct TLSData
@@ -184,15 +184,13 @@ struct TLSData
   std::vector<void *> data;
 };
 
+static thread_local TLSData *tlsData = NULL;
+
 static CriticalSection *m_TLSListLock = NULL;
 static std::vector<TLSData *> *m_TLSList = NULL;
 
 void Init()
 {
-  int err = pthread_key_create(&OSTLSHandle, NULL);
-  if(err != 0)
-    RDCFATAL("Can't allocate OS TLS slot");
-
   m_TLSListLock = new CriticalSection();
   m_TLSList = new std::vector<TLSData *>();
 
@@ -207,7 +205,8 @@ void Shutdown()
   delete m_TLSList;
   delete m_TLSListLock;
 
-  pthread_key_delete(OSTLSHandle);
+  // other threads' pointers can't be reached, but they should not be calling in after shutdown
+  tlsData = NULL;
 }
 
 // allocate a TLS slot in our per-thread vectors with an atomic increment.
@@ -221,7 +220,7 @@ uint64_t AllocateTLSSlot()
 // look up our per-thread vector.
 void *GetTLSValue(uint64_t slot)
 {
-  TLSData *slots = (TLSData *)pthread_getspecific(OSTLSHandle);
+  TLSData *slots = tlsData;
   if(slots == NULL || slot - 1 >= slots->data.size())
     return NULL;
   return slots->data[(size_t)slot - 1];
@@ -229,7 +228,7 @@ void *GetTLSValue(uint64_t slot)
 
 void SetTLSValue(uint64_t slot, void *value)
 {
-  TLSData *slots = (TLSData *)pthread_getspecific(OSTLSHandle);
+  TLSData *slots = tlsData;
 
   // resize or allocate slot data if needed.
   // We don't need to lock this, as it is by definition thread local so we are
@@ -238,8 +237,7 @@ void SetTLSValue(uint64_t slot, void *value)
   {
     if(slots == NULL)
     {
-      slots = new TLSData;
-      pthread_setspecific(OSTLSHandle, slots);
+      slots = tlsData = new TLSData;
 
       // in the case where this thread is entirely new, we globally lock so we can
       // store its data for shutdown (as we might not get notified of every thread
@@ -302,4 +300,10 @@ void Sleep(uint32_t milliseconds)
 {
   usleep(milliseconds * 1000);
 }
+
+uint32_t NumberOfCores()
+{
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? uint32_t(count) : 1;
+}
 };
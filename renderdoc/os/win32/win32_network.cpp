@@ -109,6 +109,28 @@ void Shutdown()
   WSACleanup();
 }
 
+Wakeup::Wakeup()
+{
+  handle[0] = (ptrdiff_t)CreateEvent(NULL, TRUE, FALSE, NULL);
+  handle[1] = 0;
+}
+
+Wakeup::~Wakeup()
+{
+  if(handle[0])
+    CloseHandle((HANDLE)handle[0]);
+}
+
+void Wakeup::Signal()
+{
+  SetEvent((HANDLE)handle[0]);
+}
+
+void Wakeup::Reset()
+{
+  ResetEvent((HANDLE)handle[0]);
+}
+
 Socket::~Socket()
 {
   Shutdown();
@@ -261,6 +283,23 @@ bool Socket::IsRecvDataWaiting()
   return ret > 0;
 }
 
+bool Socket::Wait(Wakeup *wakeup, uint32_t timeoutMilliseconds)
+{
+  WSAEVENT ev = WSACreateEvent();
+
+  // this also puts the socket in non-blocking mode, but all our sockets already are.
+  WSAEventSelect((SOCKET)socket, ev, FD_READ | FD_ACCEPT | FD_CLOSE);
+
+  HANDLE handles[2] = {ev, wakeup ? (HANDLE)wakeup->handle[0] : NULL};
+
+  DWORD ret = WaitForMultipleObjects(handles[1] ? 2 : 1, handles, FALSE, timeoutMilliseconds);
+
+  WSAEventSelect((SOCKET)socket, NULL, 0);
+  WSACloseEvent(ev);
+
+  return ret == WAIT_OBJECT_0;
+}
+
 bool Socket::RecvDataNonBlocking(void *buf, uint32_t &length)
 {
   if(length == 0)
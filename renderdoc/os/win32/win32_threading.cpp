@@ -168,9 +168,9 @@ static DWORD __stdcall sThreadInit(void *init)
   return 0;
 }
 
-// to not exhaust OS slots, we only allocate one that points
-// to our own array
-DWORD OSTLSHandle;
+// slots are indices into a per-thread array, so we don't exhaust OS slots. The array is found
+// through a native thread_local pointer rather than an OS slot lookup, since GetTLSValue is called
+// on every captured API call.
 int64_t nextTLSSlot = 0;
 
 struct TLSData
@@ -178,15 +178,13 @@ struct TLSData
   std::vector<void *> data;
 };
 
+static thread_local TLSData *tlsData = NULL;
+
 static CriticalSection *m_TLSListLock = NULL;
 static std::vector<TLSData *> *m_TLSList = NULL;
 
 void Init()
 {
-  OSTLSHandle = TlsAlloc();
-  if(OSTLSHandle == TLS_OUT_OF_INDEXES)
-    RDCFATAL("Can't allocate OS TLS slot");
-
   m_TLSListLock = new CriticalSection();
   m_TLSList = new std::vector<TLSData *>();
 }
@@ -202,7 +200,8 @@ void Shutdown()
   delete m_TLSList;
   delete m_TLSListLock;
 
-  TlsFree(OSTLSHandle);
+  // other threads' pointers can't be reached, but they should not be calling in after shutdown
+  tlsData = NULL;
 }
 
 // allocate a TLS slot in our per-thread vectors with an atomic increment.
@@ -216,7 +215,7 @@ uint64_t AllocateTLSSlot()
 // look up our per-thread vector.
 void *GetTLSValue(uint64_t slot)
 {
-  TLSData *slots = (TLSData *)TlsGetValue(OSTLSHandle);
+  TLSData *slots = tlsData;
   if(slots == NULL || slot - 1 >= slots->data.size())
     return NULL;
   return slots->data[(size_t)slot - 1];
@@ -224,7 +223,7 @@ void *GetTLSValue(uint64_t slot)
 
 void SetTLSValue(uint64_t slot, void *value)
 {
-  TLSData *slots = (TLSData *)TlsGetValue(OSTLSHandle);
+  TLSData *slots = tlsData;
 
   // resize or allocate slot data if needed.
   // We don't need to lock this, as it is by definition thread local so we are
@@ -233,8 +232,7 @@ void SetTLSValue(uint64_t slot, void *value)
   {
     if(slots == NULL)
     {
-      slots = new TLSData;
-      TlsSetValue(OSTLSHandle, slots);
+      slots = tlsData = new TLSData;
 
       // in the case where this thread is entirely new, we globally lock so we can
       // store its data for shutdown (as we might not get notified of every thread
@@ -305,4 +303,11 @@ void Sleep(uint32_t milliseconds)
 {
   ::Sleep((DWORD)milliseconds);
 }
+
+uint32_t NumberOfCores()
+{
+  SYSTEM_INFO info = {};
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? uint32_t(info.dwNumberOfProcessors) : 1;
+}
 };
@@ -238,28 +238,50 @@ static uint32_t DiscardFrameCapture(void *device, void *wndHandle)
   return RenderDoc::Inst().DiscardFrameCapture(device, wndHandle) ? 1 : 0;
 }
 
+static uint32_t TriggerRetroactiveCapture()
+{
+  if(RenderDoc::Inst().GetRetroactiveFrames() == 0)
+    return 0;
+
+  RenderDoc::Inst().TriggerRetroactiveCapture();
+  return 1;
+}
+
+static void GetRetroactiveCaptureStats(uint32_t *numFrames, uint64_t *memoryBytes,
+                                       float *snapshotMilliseconds)
+{
+  RetroactiveCaptureStats stats = RenderDoc::Inst().GetRetroactiveStats();
+
+  if(numFrames)
+    *numFrames = stats.frames;
+  if(memoryBytes)
+    *memoryBytes = stats.memoryBytes;
+  if(snapshotMilliseconds)
+    *snapshotMilliseconds = (float)stats.snapshotMS;
+}
+
 // defined in capture_options.cpp
 int RENDERDOC_CC SetCaptureOptionU32(RENDERDOC_CaptureOption opt, uint32_t val);
 int RENDERDOC_CC SetCaptureOptionF32(RENDERDOC_CaptureOption opt, float val);
 uint32_t RENDERDOC_CC GetCaptureOptionU32(RENDERDOC_CaptureOption opt);
 float RENDERDOC_CC GetCaptureOptionF32(RENDERDOC_CaptureOption opt);
 
-void RENDERDOC_CC GetAPIVersion_1_4_0(int *major, int *minor, int *patch)
+void RENDERDOC_CC GetAPIVersion_1_5_0(int *major, int *minor, int *patch)
 {
   if(major)
     *major = 1;
   if(minor)
-    *minor = 4;
+    *minor = 5;
   if(patch)
     *patch = 0;
 }
 
-RENDERDOC_API_1_4_0 api_1_4_0;
-void Init_1_4_0()
+RENDERDOC_API_1_5_0 api_1_5_0;
+void Init_1_5_0()
 {
-  RENDERDOC_API_1_4_0 &api = api_1_4_0;
+  RENDERDOC_API_1_5_0 &api = api_1_5_0;
 
-  api.GetAPIVersion = &GetAPIVersion_1_4_0;
+  api.GetAPIVersion = &GetAPIVersion_1_5_0;
 
   api.SetCaptureOptionU32 = &SetCaptureOptionU32;
   api.SetCaptureOptionF32 = &SetCaptureOptionF32;
@@ -298,6 +320,9 @@ void Init_1_4_0()
   api.SetCaptureFileComments = &SetCaptureFileComments;
 
   api.DiscardFrameCapture = &DiscardFrameCapture;
+
+  api.TriggerRetroactiveCapture = &TriggerRetroactiveCapture;
+  api.GetRetroactiveCaptureStats = &GetRetroactiveCaptureStats;
 }
 
 extern "C" RENDERDOC_API int RENDERDOC_CC RENDERDOC_GetAPI(RENDERDOC_Version version,
@@ -324,15 +349,16 @@ extern "C" RENDERDOC_API int RENDERDOC_CC RENDERDOC_GetAPI(RENDERDOC_Version ver
     ret = 1;                                                       \
   }
 
-  API_VERSION_HANDLE(1_0_0, 1_4_0);
-  API_VERSION_HANDLE(1_0_1, 1_4_0);
-  API_VERSION_HANDLE(1_0_2, 1_4_0);
-  API_VERSION_HANDLE(1_1_0, 1_4_0);
-  API_VERSION_HANDLE(1_1_1, 1_4_0);
-  API_VERSION_HANDLE(1_1_2, 1_4_0);
-  API_VERSION_HANDLE(1_2_0, 1_4_0);
-  API_VERSION_HANDLE(1_3_0, 1_4_0);
-  API_VERSION_HANDLE(1_4_0, 1_4_0);
+  API_VERSION_HANDLE(1_0_0, 1_5_0);
+  API_VERSION_HANDLE(1_0_1, 1_5_0);
+  API_VERSION_HANDLE(1_0_2, 1_5_0);
+  API_VERSION_HANDLE(1_1_0, 1_5_0);
+  API_VERSION_HANDLE(1_1_1, 1_5_0);
+  API_VERSION_HANDLE(1_1_2, 1_5_0);
+  API_VERSION_HANDLE(1_2_0, 1_5_0);
+  API_VERSION_HANDLE(1_3_0, 1_5_0);
+  API_VERSION_HANDLE(1_4_0, 1_5_0);
+  API_VERSION_HANDLE(1_5_0, 1_5_0);
 
 #undef API_VERSION_HANDLE
 
@@ -30,6 +30,7 @@
 #if ENABLED(ENABLE_UNIT_TESTS)
 
 #include "3rdparty/catch/catch.hpp"
+#include "common/benchmark.h"
 
 static volatile int32_t constructor = 0;
 static volatile int32_t valueConstructor = 0;
@@ -1035,4 +1036,61 @@ TEST_CASE("Test string type", "[basictypes][string]")
   };
 };
 
+TEST_CASE("Benchmark array and string types", "[basictypes][!benchmark]")
+{
+  const int count = 100000;
+
+  RunBenchmark("rdcarray<uint32_t> push_back 100000", count * sizeof(uint32_t), [&]() {
+    rdcarray<uint32_t> arr;
+    for(int i = 0; i < count; i++)
+      arr.push_back(i);
+    BenchmarkKeep(arr.back());
+  });
+
+  rdcarray<uint32_t> source;
+  source.resize(count);
+  for(int i = 0; i < count; i++)
+    source[i] = i;
+
+  RunBenchmark("rdcarray<uint32_t> copy 100000", count * sizeof(uint32_t), [&]() {
+    rdcarray<uint32_t> arr = source;
+    BenchmarkKeep(arr.back());
+  });
+
+  RunBenchmark("rdcarray<uint32_t> insert at front 1000", 0, [&]() {
+    rdcarray<uint32_t> arr;
+    for(uint32_t i = 0; i < 1000; i++)
+      arr.insert(0, &i, 1);
+    BenchmarkKeep(arr.back());
+  });
+
+  RunBenchmark("rdcarray<rdcstr> push_back 10000", 0, [&]() {
+    rdcarray<rdcstr> arr;
+    for(int i = 0; i < 10000; i++)
+      arr.push_back("A string that is too long to be stored inline");
+    BenchmarkKeep(arr.back().size());
+  });
+
+  RunBenchmark("rdcstr append 100000 chars", count, [&]() {
+    rdcstr str;
+    for(int i = 0; i < count; i++)
+      str.push_back(char('a' + (i % 26)));
+    BenchmarkKeep(str.size());
+  });
+
+  rdcstr haystack;
+  for(int i = 0; i < count; i++)
+    haystack.push_back(char('a' + (i % 26)));
+  haystack += "needle";
+
+  RunBenchmark("rdcstr find in 100000 chars", count, [&]() {
+    BenchmarkKeep((uint64_t)haystack.find("needle"));
+  });
+
+  RunBenchmark("rdcstr compare 100000 chars", count, [&]() {
+    rdcstr copy = haystack;
+    BenchmarkKeep(copy == haystack ? 1 : 0);
+  });
+}
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
\ No newline at end of file
@@ -56,6 +56,12 @@ int RENDERDOC_CC SetCaptureOptionU32(RENDERDOC_CaptureOption opt, uint32_t val)
       else
         RDCWARN("AllowUnsupportedVendorExtensions unexpected parameter %x", val);
       break;
+    case eRENDERDOC_Option_RetroactiveCaptureFrames:
+      RenderDoc::Inst().SetRetroactiveFrames(val);
+      break;
+    case eRENDERDOC_Option_RetroactiveCaptureMemoryMB:
+      RenderDoc::Inst().SetRetroactiveMemoryBudget(val);
+      break;
     default: RDCLOG("Unrecognised capture option '%d'", opt); return 0;
   }
 
@@ -88,6 +94,12 @@ int RENDERDOC_CC SetCaptureOptionF32(RENDERDOC_CaptureOption opt, float val)
     case eRENDERDOC_Option_AllowUnsupportedVendorExtensions:
       RDCWARN("AllowUnsupportedVendorExtensions unexpected parameter %f", val);
       break;
+    case eRENDERDOC_Option_RetroactiveCaptureFrames:
+      RenderDoc::Inst().SetRetroactiveFrames((uint32_t)val);
+      break;
+    case eRENDERDOC_Option_RetroactiveCaptureMemoryMB:
+      RenderDoc::Inst().SetRetroactiveMemoryBudget((uint32_t)val);
+      break;
     default: RDCLOG("Unrecognised capture option '%d'", opt); return 0;
   }
 
@@ -125,6 +137,10 @@ uint32_t RENDERDOC_CC GetCaptureOptionU32(RENDERDOC_CaptureOption opt)
     case eRENDERDOC_Option_DebugOutputMute:
       return (RenderDoc::Inst().GetCaptureOptions().debugOutputMute ? 1 : 0);
     case eRENDERDOC_Option_AllowUnsupportedVendorExtensions: return 0;
+    case eRENDERDOC_Option_RetroactiveCaptureFrames:
+      return RenderDoc::Inst().GetRetroactiveFrames();
+    case eRENDERDOC_Option_RetroactiveCaptureMemoryMB:
+      return RenderDoc::Inst().GetRetroactiveMemoryBudget();
     default: break;
   }
 
@@ -162,6 +178,10 @@ float RENDERDOC_CC GetCaptureOptionF32(RENDERDOC_CaptureOption opt)
     case eRENDERDOC_Option_DebugOutputMute:
       return (RenderDoc::Inst().GetCaptureOptions().debugOutputMute ? 1.0f : 0.0f);
     case eRENDERDOC_Option_AllowUnsupportedVendorExtensions: return 0.0f;
+    case eRENDERDOC_Option_RetroactiveCaptureFrames:
+      return (float)RenderDoc::Inst().GetRetroactiveFrames();
+    case eRENDERDOC_Option_RetroactiveCaptureMemoryMB:
+      return (float)RenderDoc::Inst().GetRetroactiveMemoryBudget();
     default: break;
   }
 
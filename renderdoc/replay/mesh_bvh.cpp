@@ -0,0 +1,278 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "mesh_bvh.h"
+#include <float.h>
+#include <algorithm>
+#include "common/common.h"
+
+static const uint32_t MaxLeafTriangles = 4;
+
+static inline float Axis(const Vec3f &v, uint32_t axis)
+{
+  return axis == 0 ? v.x : (axis == 1 ? v.y : v.z);
+}
+
+static inline bool SamePosition(const Vec3f &a, const Vec3f &b)
+{
+  return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+// identical to TriangleRayIntersect in the picking shaders, returning the distance along the ray
+static bool TriangleRayIntersect(const MeshBVH::Triangle &tri, const Vec3f &rayPos,
+                                 const Vec3f &rayDir, float &t)
+{
+  const Vec3f &A = tri.pos[0];
+  const Vec3f &B = tri.pos[1];
+  const Vec3f &C = tri.pos[2];
+
+  if(SamePosition(A, B) || SamePosition(A, C) || SamePosition(B, C))
+    return false;
+
+  Vec3f v0v1 = B - A;
+  Vec3f v0v2 = C - A;
+  Vec3f pvec = rayDir.Cross(v0v2);
+  float det = v0v1.Dot(pvec);
+
+  // backfacing triangles are picked too
+  if(fabsf(det) > 0.0f)
+  {
+    float invDet = 1.0f / det;
+
+    Vec3f tvec = rayPos - A;
+    Vec3f qvec = tvec.Cross(v0v1);
+    float u = tvec.Dot(pvec) * invDet;
+    float v = rayDir.Dot(qvec) * invDet;
+
+    if(u >= 0.0f && u <= 1.0f && v >= 0.0f && u + v <= 1.0f)
+    {
+      t = v0v2.Dot(qvec) * invDet;
+      return t > 0.0f;
+    }
+  }
+
+  return false;
+}
+
+// return the corner closest to the hit, the same way the shaders do
+static uint32_t ClosestCorner(const MeshBVH::Triangle &tri, const Vec3f &hit)
+{
+  float dist0 = (tri.pos[0] - hit).Length();
+  float dist1 = (tri.pos[1] - hit).Length();
+  float dist2 = (tri.pos[2] - hit).Length();
+
+  if(dist1 < dist0 && dist1 < dist2)
+    return tri.vertid[1];
+  else if(dist2 < dist0 && dist2 < dist1)
+    return tri.vertid[2];
+
+  return tri.vertid[0];
+}
+
+static bool RayBoxIntersect(const Vec3f &boundsMin, const Vec3f &boundsMax, const Vec3f &rayPos,
+                            const Vec3f &invDir, float maxT)
+{
+  float tmin = 0.0f;
+  float tmax = maxT;
+
+  for(uint32_t axis = 0; axis < 3; axis++)
+  {
+    float t0 = (Axis(boundsMin, axis) - Axis(rayPos, axis)) * Axis(invDir, axis);
+    float t1 = (Axis(boundsMax, axis) - Axis(rayPos, axis)) * Axis(invDir, axis);
+
+    if(t0 > t1)
+      std::swap(t0, t1);
+
+    // written so that a NaN from a ray lying on a slab's plane doesn't reject the box
+    tmin = t0 > tmin ? t0 : tmin;
+    tmax = t1 < tmax ? t1 : tmax;
+
+    if(tmin > tmax)
+      return false;
+  }
+
+  return true;
+}
+
+void MeshBVH::Build(std::vector<Triangle> &&triangles, volatile int32_t *cancel)
+{
+  m_Nodes.clear();
+  m_Triangles.swap(triangles);
+
+  if(m_Triangles.empty())
+    return;
+
+  m_Nodes.reserve(m_Triangles.size() * 2 / MaxLeafTriangles + 1);
+
+  BuildNode(0, (uint32_t)m_Triangles.size(), cancel);
+
+  if(cancel && *cancel)
+  {
+    m_Nodes.clear();
+    m_Triangles.clear();
+  }
+}
+
+uint32_t MeshBVH::BuildNode(uint32_t begin, uint32_t end, volatile int32_t *cancel)
+{
+  uint32_t idx = (uint32_t)m_Nodes.size();
+  m_Nodes.push_back(Node());
+
+  if(cancel && *cancel)
+    return idx;
+
+  Vec3f boundsMin(FLT_MAX, FLT_MAX, FLT_MAX);
+  Vec3f boundsMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+  // centroids are kept as the sum of the corners, we only compare them against each other
+  Vec3f centroidMin(FLT_MAX, FLT_MAX, FLT_MAX);
+  Vec3f centroidMax(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+
+  for(uint32_t i = begin; i < end; i++)
+  {
+    const Triangle &tri = m_Triangles[i];
+
+    for(int c = 0; c < 3; c++)
+    {
+      boundsMin = Vec3f(RDCMIN(boundsMin.x, tri.pos[c].x), RDCMIN(boundsMin.y, tri.pos[c].y),
+                        RDCMIN(boundsMin.z, tri.pos[c].z));
+      boundsMax = Vec3f(RDCMAX(boundsMax.x, tri.pos[c].x), RDCMAX(boundsMax.y, tri.pos[c].y),
+                        RDCMAX(boundsMax.z, tri.pos[c].z));
+    }
+
+    Vec3f centroid = tri.pos[0] + tri.pos[1] + tri.pos[2];
+
+    centroidMin = Vec3f(RDCMIN(centroidMin.x, centroid.x), RDCMIN(centroidMin.y, centroid.y),
+                        RDCMIN(centroidMin.z, centroid.z));
+    centroidMax = Vec3f(RDCMAX(centroidMax.x, centroid.x), RDCMAX(centroidMax.y, centroid.y),
+                        RDCMAX(centroidMax.z, centroid.z));
+  }
+
+  m_Nodes[idx].boundsMin = boundsMin;
+  m_Nodes[idx].boundsMax = boundsMax;
+
+  Vec3f extent = centroidMax - centroidMin;
+
+  uint32_t axis = 0;
+  if(extent.y > extent.x)
+    axis = 1;
+  if(extent.z > Axis(extent, axis))
+    axis = 2;
+
+  // make a leaf if there are few enough triangles, or they can't be separated. NaN positions will
+  // also end up here, since the extent comparison fails.
+  if(end - begin <= MaxLeafTriangles || !(Axis(extent, axis) > 0.0f))
+  {
+    m_Nodes[idx].first = begin;
+    m_Nodes[idx].count = end - begin;
+    return idx;
+  }
+
+  // split at the median along the longest axis
+  uint32_t mid = begin + (end - begin) / 2;
+
+  std::nth_element(m_Triangles.begin() + begin, m_Triangles.begin() + mid,
+                   m_Triangles.begin() + end, [axis](const Triangle &a, const Triangle &b) {
+                     return Axis(a.pos[0] + a.pos[1] + a.pos[2], axis) <
+                            Axis(b.pos[0] + b.pos[1] + b.pos[2], axis);
+                   });
+
+  BuildNode(begin, mid, cancel);
+  uint32_t right = BuildNode(mid, end, cancel);
+
+  m_Nodes[idx].first = right;
+  m_Nodes[idx].count = 0;
+
+  return idx;
+}
+
+uint32_t MeshBVH::Pick(const Vec3f &rayPos, const Vec3f &rayDir) const
+{
+  if(m_Nodes.empty())
+    return ~0U;
+
+  Vec3f invDir(1.0f / rayDir.x, 1.0f / rayDir.y, 1.0f / rayDir.z);
+
+  const Triangle *closest = NULL;
+  float closestT = FLT_MAX;
+
+  // median splits keep the tree balanced, so this is far deeper than any real mesh needs
+  uint32_t stack[128];
+  uint32_t stackSize = 0;
+
+  stack[stackSize++] = 0;
+
+  while(stackSize > 0)
+  {
+    const Node &node = m_Nodes[stack[--stackSize]];
+
+    if(!RayBoxIntersect(node.boundsMin, node.boundsMax, rayPos, invDir, closestT))
+      continue;
+
+    if(node.count > 0)
+    {
+      for(uint32_t i = node.first; i < node.first + node.count; i++)
+      {
+        float t = 0.0f;
+        if(TriangleRayIntersect(m_Triangles[i], rayPos, rayDir, t) && t < closestT)
+        {
+          closestT = t;
+          closest = &m_Triangles[i];
+        }
+      }
+    }
+    else if(stackSize + 2 <= ARRAY_COUNT(stack))
+    {
+      stack[stackSize++] = node.first;
+      stack[stackSize++] = uint32_t(&node - m_Nodes.data()) + 1;
+    }
+  }
+
+  if(closest == NULL)
+    return ~0U;
+
+  return ClosestCorner(*closest, rayPos + rayDir * closestT);
+}
+
+uint32_t MeshBVH::PickBruteForce(const std::vector<Triangle> &triangles, const Vec3f &rayPos,
+                                 const Vec3f &rayDir)
+{
+  const Triangle *closest = NULL;
+  float closestT = FLT_MAX;
+
+  for(const Triangle &tri : triangles)
+  {
+    float t = 0.0f;
+    if(TriangleRayIntersect(tri, rayPos, rayDir, t) && t < closestT)
+    {
+      closestT = t;
+      closest = &tri;
+    }
+  }
+
+  if(closest == NULL)
+    return ~0U;
+
+  return ClosestCorner(*closest, rayPos + rayDir * closestT);
+}
@@ -0,0 +1,69 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#pragma once
+
+#include <stdint.h>
+#include <vector>
+#include "maths/vec.h"
+
+// bounding volume hierarchy over a triangle mesh, so that vertices can be picked with a ray on the
+// CPU without testing every triangle. The results match the brute-force GPU picking shaders.
+class MeshBVH
+{
+public:
+  struct Triangle
+  {
+    Vec3f pos[3];
+    // the position in the index stream of each corner, this is what picking returns
+    uint32_t vertid[3];
+  };
+
+  // builds the hierarchy, taking the triangles and reordering them. If cancel is set and becomes
+  // non-zero while building, the build stops and leaves the BVH empty.
+  void Build(std::vector<Triangle> &&triangles, volatile int32_t *cancel = NULL);
+
+  // returns the corner nearest the closest intersection along the ray, or ~0U on a miss
+  uint32_t Pick(const Vec3f &rayPos, const Vec3f &rayDir) const;
+
+  // tests every triangle, for reference
+  static uint32_t PickBruteForce(const std::vector<Triangle> &triangles, const Vec3f &rayPos,
+                                 const Vec3f &rayDir);
+
+  size_t NumTriangles() const { return m_Triangles.size(); }
+  size_t NumNodes() const { return m_Nodes.size(); }
+private:
+  struct Node
+  {
+    Vec3f boundsMin, boundsMax;
+    // for a leaf the triangles [first, first+count). For an interior node count is 0, the left
+    // child immediately follows this node and first is the index of the right child.
+    uint32_t first, count;
+  };
+
+  uint32_t BuildNode(uint32_t begin, uint32_t end, volatile int32_t *cancel);
+
+  std::vector<Node> m_Nodes;
+  std::vector<Triangle> m_Triangles;
+};
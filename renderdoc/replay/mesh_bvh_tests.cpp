@@ -0,0 +1,280 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include "mesh_bvh.h"
+#include "common/globalconfig.h"
+
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "3rdparty/catch/catch.hpp"
+#include "common/common.h"
+#include "common/timing.h"
+
+// deterministic so that failures can be reproduced
+struct TestRandom
+{
+  uint32_t state = 12345;
+
+  float Next(float minVal, float maxVal)
+  {
+    state = state * 1664525U + 1013904223U;
+    return minVal + (maxVal - minVal) * float(state >> 8) / float(1 << 24);
+  }
+
+  Vec3f NextVec(float minVal, float maxVal)
+  {
+    float x = Next(minVal, maxVal);
+    float y = Next(minVal, maxVal);
+    float z = Next(minVal, maxVal);
+    return Vec3f(x, y, z);
+  }
+};
+
+// a wavy heightfield of gridSize x gridSize quads, like a terrain mesh
+static std::vector<MeshBVH::Triangle> MakeGrid(uint32_t gridSize)
+{
+  std::vector<MeshBVH::Triangle> ret;
+  ret.reserve(gridSize * gridSize * 2);
+
+  auto pos = [gridSize](uint32_t x, uint32_t y) {
+    float fx = float(x) / float(gridSize) * 20.0f - 10.0f;
+    float fy = float(y) / float(gridSize) * 20.0f - 10.0f;
+    return Vec3f(fx, sinf(fx) * cosf(fy), fy);
+  };
+
+  uint32_t vertid = 0;
+
+  for(uint32_t y = 0; y < gridSize; y++)
+  {
+    for(uint32_t x = 0; x < gridSize; x++)
+    {
+      MeshBVH::Triangle tri;
+
+      tri.pos[0] = pos(x, y);
+      tri.pos[1] = pos(x + 1, y);
+      tri.pos[2] = pos(x, y + 1);
+      for(int c = 0; c < 3; c++)
+        tri.vertid[c] = vertid++;
+      ret.push_back(tri);
+
+      tri.pos[0] = pos(x + 1, y);
+      tri.pos[1] = pos(x + 1, y + 1);
+      tri.pos[2] = pos(x, y + 1);
+      for(int c = 0; c < 3; c++)
+        tri.vertid[c] = vertid++;
+      ret.push_back(tri);
+    }
+  }
+
+  return ret;
+}
+
+// randomly placed and overlapping triangles, the worst case for a BVH
+static std::vector<MeshBVH::Triangle> MakeSoup(uint32_t count, TestRandom &rand)
+{
+  std::vector<MeshBVH::Triangle> ret;
+  ret.resize(count);
+
+  for(uint32_t i = 0; i < count; i++)
+  {
+    Vec3f centre = rand.NextVec(-10.0f, 10.0f);
+    for(int c = 0; c < 3; c++)
+    {
+      ret[i].pos[c] = centre + rand.NextVec(-1.0f, 1.0f);
+      ret[i].vertid[c] = i * 3 + c;
+    }
+  }
+
+  return ret;
+}
+
+// rays from outside the mesh pointed at a random point inside it
+static void MakeRay(TestRandom &rand, Vec3f &rayPos, Vec3f &rayDir)
+{
+  rayPos = rand.NextVec(-30.0f, 30.0f);
+  rayDir = rand.NextVec(-8.0f, 8.0f) - rayPos;
+  rayDir.Normalise();
+}
+
+TEST_CASE("Test mesh BVH picking", "[meshbvh]")
+{
+  TestRandom rand;
+
+  SECTION("Empty mesh")
+  {
+    MeshBVH bvh;
+    bvh.Build({});
+
+    CHECK(bvh.NumTriangles() == 0);
+    CHECK(bvh.Pick(Vec3f(0.0f, 0.0f, -5.0f), Vec3f(0.0f, 0.0f, 1.0f)) == ~0U);
+  };
+
+  SECTION("Single triangle")
+  {
+    MeshBVH::Triangle tri;
+    tri.pos[0] = Vec3f(-1.0f, -1.0f, 0.0f);
+    tri.pos[1] = Vec3f(1.0f, -1.0f, 0.0f);
+    tri.pos[2] = Vec3f(0.0f, 1.0f, 0.0f);
+    tri.vertid[0] = 10;
+    tri.vertid[1] = 11;
+    tri.vertid[2] = 12;
+
+    MeshBVH bvh;
+    bvh.Build({tri});
+
+    // the nearest corner to the hit is returned
+    CHECK(bvh.Pick(Vec3f(0.9f, -0.9f, -5.0f), Vec3f(0.0f, 0.0f, 1.0f)) == 11);
+    CHECK(bvh.Pick(Vec3f(0.0f, 0.9f, 5.0f), Vec3f(0.0f, 0.0f, -1.0f)) == 12);
+
+    // misses to the side, and behind the ray's origin
+    CHECK(bvh.Pick(Vec3f(2.0f, 0.0f, -5.0f), Vec3f(0.0f, 0.0f, 1.0f)) == ~0U);
+    CHECK(bvh.Pick(Vec3f(0.0f, 0.0f, 5.0f), Vec3f(0.0f, 0.0f, 1.0f)) == ~0U);
+  };
+
+  SECTION("Degenerate triangles are never picked")
+  {
+    MeshBVH::Triangle tri;
+    tri.pos[0] = Vec3f(-1.0f, -1.0f, 0.0f);
+    tri.pos[1] = Vec3f(-1.0f, -1.0f, 0.0f);
+    tri.pos[2] = Vec3f(0.0f, 1.0f, 0.0f);
+    tri.vertid[0] = tri.vertid[1] = tri.vertid[2] = 0;
+
+    MeshBVH bvh;
+    bvh.Build({tri, tri, tri, tri, tri, tri});
+
+    CHECK(bvh.Pick(Vec3f(-0.5f, 0.0f, -5.0f), Vec3f(0.0f, 0.0f, 1.0f)) == ~0U);
+  };
+
+  SECTION("Closest hit wins")
+  {
+    std::vector<MeshBVH::Triangle> tris;
+    for(uint32_t i = 0; i < 100; i++)
+    {
+      MeshBVH::Triangle tri;
+      float z = float((i * 37) % 100);
+      tri.pos[0] = Vec3f(-1.0f, -1.0f, z);
+      tri.pos[1] = Vec3f(1.0f, -1.0f, z);
+      tri.pos[2] = Vec3f(0.0f, 1.0f, z);
+      tri.vertid[0] = tri.vertid[1] = tri.vertid[2] = uint32_t(z);
+      tris.push_back(tri);
+    }
+
+    MeshBVH bvh;
+    bvh.Build(std::move(tris));
+
+    CHECK(bvh.Pick(Vec3f(0.0f, 0.0f, -5.0f), Vec3f(0.0f, 0.0f, 1.0f)) == 0);
+    CHECK(bvh.Pick(Vec3f(0.0f, 0.0f, 50.5f), Vec3f(0.0f, 0.0f, 1.0f)) == 51);
+    CHECK(bvh.Pick(Vec3f(0.0f, 0.0f, 50.5f), Vec3f(0.0f, 0.0f, -1.0f)) == 50);
+  };
+
+  SECTION("Matches brute force")
+  {
+    std::vector<MeshBVH::Triangle> meshes[] = {MakeGrid(64), MakeSoup(5000, rand)};
+
+    for(const std::vector<MeshBVH::Triangle> &mesh : meshes)
+    {
+      MeshBVH bvh;
+      bvh.Build(std::vector<MeshBVH::Triangle>(mesh));
+
+      CHECK(bvh.NumTriangles() == mesh.size());
+
+      uint32_t hits = 0;
+
+      for(int i = 0; i < 500; i++)
+      {
+        Vec3f rayPos, rayDir;
+        MakeRay(rand, rayPos, rayDir);
+
+        uint32_t expected = MeshBVH::PickBruteForce(mesh, rayPos, rayDir);
+
+        INFO("ray " << i);
+        CHECK(bvh.Pick(rayPos, rayDir) == expected);
+
+        if(expected != ~0U)
+          hits++;
+      }
+
+      // make sure the test is actually testing something
+      CHECK(hits > 100);
+    }
+  };
+
+  SECTION("Cancelled build is empty")
+  {
+    int32_t cancel = 1;
+
+    MeshBVH bvh;
+    bvh.Build(MakeGrid(16), &cancel);
+
+    CHECK(bvh.NumTriangles() == 0);
+    CHECK(bvh.NumNodes() == 0);
+  };
+
+  SECTION("Performance")
+  {
+    std::vector<MeshBVH::Triangle> mesh = MakeGrid(512);
+
+    const size_t numTris = mesh.size();
+    const int numRays = 200;
+
+    std::vector<Vec3f> rays;
+    for(int i = 0; i < numRays; i++)
+    {
+      Vec3f rayPos, rayDir;
+      MakeRay(rand, rayPos, rayDir);
+      rays.push_back(rayPos);
+      rays.push_back(rayDir);
+    }
+
+    PerformanceTimer timer;
+
+    uint32_t bruteSum = 0;
+    for(int i = 0; i < numRays; i++)
+      bruteSum += MeshBVH::PickBruteForce(mesh, rays[i * 2], rays[i * 2 + 1]);
+
+    double bruteMs = timer.GetMilliseconds();
+
+    timer.Restart();
+
+    MeshBVH bvh;
+    bvh.Build(std::move(mesh));
+
+    double buildMs = timer.GetMilliseconds();
+
+    timer.Restart();
+
+    uint32_t bvhSum = 0;
+    for(int i = 0; i < numRays; i++)
+      bvhSum += bvh.Pick(rays[i * 2], rays[i * 2 + 1]);
+
+    double pickMs = timer.GetMilliseconds();
+
+    CHECK(bvhSum == bruteSum);
+
+    RDCLOG("Mesh BVH over %zu triangles: build %.2f ms, %.4f ms per pick vs %.4f ms brute force",
+           numTris, buildMs, pickMs / numRays, bruteMs / numRays);
+  };
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -479,6 +479,20 @@ void DoSerialise(SerialiserType &ser, DriverInformation &el)
   SIZE_CHECK(132);
 }
 
+template <typename SerialiserType>
+void DoSerialise(SerialiserType &ser, InitialStateRestoreStats &el)
+{
+  SERIALISE_MEMBER(numRestores);
+  SERIALISE_MEMBER(lastRestoredResources);
+  SERIALISE_MEMBER(lastSkippedResources);
+  SERIALISE_MEMBER(lastRestoredBytes);
+  SERIALISE_MEMBER(lastSkippedBytes);
+  SERIALISE_MEMBER(totalRestoredBytes);
+  SERIALISE_MEMBER(totalSkippedBytes);
+
+  SIZE_CHECK(48);
+}
+
 template <typename SerialiserType>
 void DoSerialise(SerialiserType &ser, DebugMessage &el)
 {
@@ -2239,6 +2253,7 @@ INSTANTIATE_SERIALISE_TYPE(TextureDescription)
 INSTANTIATE_SERIALISE_TYPE(BufferDescription)
 INSTANTIATE_SERIALISE_TYPE(APIProperties)
 INSTANTIATE_SERIALISE_TYPE(DriverInformation)
+INSTANTIATE_SERIALISE_TYPE(InitialStateRestoreStats)
 INSTANTIATE_SERIALISE_TYPE(DebugMessage)
 INSTANTIATE_SERIALISE_TYPE(APIEvent)
 INSTANTIATE_SERIALISE_TYPE(DrawcallDescription)
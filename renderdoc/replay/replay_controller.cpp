@@ -26,6 +26,7 @@
 #include "replay_controller.h"
 #include <string.h>
 #include <time.h>
+#include <algorithm>
 #include "common/dds_readwrite.h"
 #include "driver/ihv/amd/amd_isa.h"
 #include "driver/ihv/amd/amd_rgp.h"
@@ -303,6 +304,13 @@ FrameDescription ReplayController::GetFrameInfo()
   return m_FrameRecord.frameInfo;
 }
 
+InitialStateRestoreStats ReplayController::GetInitialStateRestoreStats()
+{
+  CHECK_REPLAY_THREAD();
+
+  return m_pDevice->GetInitialStateRestoreStats();
+}
+
 const SDFile &ReplayController::GetStructuredFile()
 {
   CHECK_REPLAY_THREAD();
@@ -630,6 +638,74 @@ MeshFormat ReplayController::GetPostVSData(uint32_t instID, uint32_t viewID, Mes
   return m_pDevice->GetPostVSBuffers(draw->eventId, instID, viewID, stage);
 }
 
+rdcarray<MeshFormat> ReplayController::GetPostVSDataForEvents(const rdcarray<uint32_t> &eventIds,
+                                                              uint32_t instID, uint32_t viewID,
+                                                              MeshDataStage stage)
+{
+  CHECK_REPLAY_THREAD();
+
+  std::vector<uint32_t> draws;
+
+  for(uint32_t eid : eventIds)
+  {
+    DrawcallDescription *draw = GetDrawcallByEID(eid);
+
+    if(draw && (draw->flags & DrawFlags::Drawcall))
+      draws.push_back(draw->eventId);
+  }
+
+  std::sort(draws.begin(), draws.end());
+  draws.erase(std::unique(draws.begin(), draws.end()), draws.end());
+
+  // work backwards, batching every requested draw in the same pass as the last one so the whole
+  // batch is fetched in one replay. The pass events include the start of the pass, which is kept
+  // so the batch replays from the right place.
+  while(!draws.empty())
+  {
+    uint32_t last = draws.back();
+
+    std::vector<uint32_t> passEvents = m_pDevice->GetPassEvents(last);
+
+    if(passEvents.empty())
+    {
+      m_pDevice->InitPostVSBuffers(last);
+      draws.pop_back();
+      continue;
+    }
+
+    auto first = std::lower_bound(draws.begin(), draws.end(), passEvents.front());
+
+    std::vector<uint32_t> batch;
+    batch.push_back(passEvents.front());
+    for(auto it = first; it != draws.end(); ++it)
+      if(*it != passEvents.front())
+        batch.push_back(*it);
+
+    draws.erase(first, draws.end());
+
+    m_pDevice->InitPostVSBuffers(batch);
+  }
+
+  rdcarray<MeshFormat> ret;
+  ret.resize(eventIds.size());
+
+  for(size_t i = 0; i < eventIds.size(); i++)
+  {
+    DrawcallDescription *draw = GetDrawcallByEID(eventIds[i]);
+
+    if(draw == NULL || !(draw->flags & DrawFlags::Drawcall))
+      continue;
+
+    ret[i] = m_pDevice->GetPostVSBuffers(draw->eventId, RDCMIN(instID, draw->numInstances - 1),
+                                         viewID, stage);
+  }
+
+  // the batches replayed to arbitrary points, put the replay back where it was
+  SetFrameEvent(m_EventID, true);
+
+  return ret;
+}
+
 bytebuf ReplayController::GetBufferData(ResourceId buff, uint64_t offset, uint64_t len)
 {
   CHECK_REPLAY_THREAD();
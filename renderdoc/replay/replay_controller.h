@@ -170,6 +170,7 @@ public:
   void FreeTargetResource(ResourceId id);
 
   FrameDescription GetFrameInfo();
+  InitialStateRestoreStats GetInitialStateRestoreStats();
   const SDFile &GetStructuredFile();
   const rdcarray<DrawcallDescription> &GetDrawcalls();
   void AddFakeMarkers();
@@ -194,6 +195,8 @@ public:
   void FreeTrace(ShaderDebugTrace *trace);
 
   MeshFormat GetPostVSData(uint32_t instID, uint32_t viewID, MeshDataStage stage);
+  rdcarray<MeshFormat> GetPostVSDataForEvents(const rdcarray<uint32_t> &eventIds, uint32_t instID,
+                                              uint32_t viewID, MeshDataStage stage);
 
   rdcarray<EventUsage> GetUsage(ResourceId id);
 
@@ -1160,6 +1160,255 @@ bool HighlightCache::FetchHighlightPositions(const MeshDisplay &cfg, FloatVector
   return valid;
 }
 
+// at most this many meshes keep a BVH around
+static const size_t MaxPickCacheEntries = 8;
+
+// meshes up to this size are built immediately instead of on a worker thread
+static const uint32_t SyncPickBuildIndices = 3 * 16384;
+
+void MeshPickCache::Clear()
+{
+  for(Entry *entry : m_Entries)
+  {
+    if(entry->thread)
+    {
+      Atomic::CmpExch32(&entry->cancel, 0, 1);
+      Threading::JoinThread(entry->thread);
+      Threading::CloseThread(entry->thread);
+    }
+
+    delete entry;
+  }
+
+  m_Entries.clear();
+}
+
+void MeshPickCache::BuildEntry(Entry *entry)
+{
+  const MeshDisplay &cfg = entry->cfg;
+  const HighlightCache &source = entry->source;
+
+  const byte *data = source.vertexData.data();
+  const byte *dataEnd = data + source.vertexData.size();
+
+  Topology topo = cfg.position.topology;
+
+  // fans with restart were decomposed into a list when the indices were fetched
+  if(topo == Topology::TriangleFan && cfg.position.allowRestart && source.idxData)
+    topo = Topology::TriangleList;
+
+  uint32_t count = source.idxData ? (uint32_t)source.indices.size() : cfg.position.numIndices;
+
+  // the number of triangles, the stride between them and the offsets of their corners in the index
+  // stream. These match the picking shaders, including which corners are used with adjacency.
+  uint32_t numTris = 0;
+  uint32_t triStride = 1;
+  uint32_t corners[3] = {0, 1, 2};
+
+  switch(topo)
+  {
+    case Topology::TriangleList:
+      numTris = count / 3;
+      triStride = 3;
+      break;
+    case Topology::TriangleStrip:
+    case Topology::TriangleFan: numTris = count >= 3 ? count - 2 : 0; break;
+    case Topology::TriangleList_Adj:
+      numTris = count / 6;
+      triStride = 6;
+      corners[1] = 2;
+      corners[2] = 4;
+      break;
+    case Topology::TriangleStrip_Adj:
+      numTris = count >= 6 ? (count - 4) / 2 : 0;
+      triStride = 2;
+      corners[1] = 2;
+      corners[2] = 4;
+      break;
+    default: break;
+  }
+
+  std::vector<MeshBVH::Triangle> tris;
+  tris.reserve(numTris);
+
+  for(uint32_t t = 0; t < numTris; t++)
+  {
+    MeshBVH::Triangle tri;
+
+    bool valid = true;
+
+    for(int c = 0; c < 3; c++)
+    {
+      uint32_t vertid = t * triStride + corners[c];
+
+      // fans pivot around the first vertex
+      if(topo == Topology::TriangleFan && c == 0)
+        vertid = 0;
+
+      uint32_t idx = source.idxData ? source.indices[vertid] : vertid;
+
+      if(source.idxData && cfg.position.allowRestart && idx == cfg.position.restartIndex)
+        valid = false;
+
+      FloatVector pos = HighlightCache::InterpretVertex(
+          data, idx, cfg.position.vertexByteStride, cfg.position.format, dataEnd, valid);
+
+      if(cfg.position.unproject)
+      {
+        if(entry->flipY)
+          pos.y = -pos.y;
+
+        pos.x /= pos.w;
+        pos.y /= pos.w;
+        pos.z /= pos.w;
+      }
+
+      tri.pos[c] = Vec3f(pos.x, pos.y, pos.z);
+      tri.vertid[c] = vertid;
+    }
+
+    if(valid)
+      tris.push_back(tri);
+  }
+
+  entry->source = HighlightCache();
+
+  entry->bvh.Build(std::move(tris), &entry->cancel);
+}
+
+bool MeshPickCache::PickTriangles(uint32_t eventId, const MeshDisplay &cfg, bool flipY,
+                                  const Vec3f &rayPos, const Vec3f &rayDir, uint32_t &vertid)
+{
+  // points and lines are picked by screen distance, which isn't worth accelerating
+  switch(cfg.position.topology)
+  {
+    case Topology::TriangleList:
+    case Topology::TriangleStrip:
+    case Topology::TriangleFan:
+    case Topology::TriangleList_Adj:
+    case Topology::TriangleStrip_Adj: break;
+    default: return false;
+  }
+
+  uint64_t key = 5381;
+
+  key = inthash(eventId, key);
+  key = inthash((uint64_t)cfg.type, key);
+  key = inthash(cfg.position.indexResourceId, key);
+  key = inthash(cfg.position.indexByteOffset, key);
+  key = inthash(cfg.position.indexByteStride, key);
+  key = inthash(cfg.position.numIndices, key);
+  key = inthash((uint64_t)cfg.position.baseVertex, key);
+  key = inthash((uint64_t)cfg.position.topology, key);
+  key = inthash(cfg.position.vertexResourceId, key);
+  key = inthash(cfg.position.vertexByteOffset, key);
+  key = inthash(cfg.position.vertexByteStride, key);
+  key = inthash((uint64_t)cfg.position.format.type, key);
+  key = inthash((uint64_t)cfg.position.format.compType, key);
+  key = inthash((uint64_t)cfg.position.format.compCount, key);
+  key = inthash((uint64_t)cfg.position.format.compByteWidth, key);
+  key = inthash((uint64_t)cfg.position.allowRestart, key);
+  key = inthash((uint64_t)cfg.position.restartIndex, key);
+  key = inthash((uint64_t)cfg.position.unproject, key);
+  key = inthash((uint64_t)flipY, key);
+
+  m_UseCounter++;
+
+  Entry *entry = NULL;
+  bool building = false;
+
+  for(Entry *e : m_Entries)
+  {
+    // use an exchange to read with a barrier, so the BVH written on the worker is visible
+    bool ready = Atomic::CmpExch32(&e->ready, 1, 1) == 1;
+
+    if(e->key == key)
+    {
+      entry = e;
+
+      if(!ready)
+        return false;
+    }
+    else if(!ready)
+    {
+      building = true;
+    }
+  }
+
+  if(entry)
+  {
+    if(entry->thread)
+    {
+      Threading::JoinThread(entry->thread);
+      Threading::CloseThread(entry->thread);
+      entry->thread = 0;
+    }
+
+    entry->lastUse = m_UseCounter;
+    vertid = entry->bvh.Pick(rayPos, rayDir);
+    return true;
+  }
+
+  // only build one mesh in the background at a time, when hovering over many instances we pick in
+  // every one of them.
+  if(building && cfg.position.numIndices > SyncPickBuildIndices)
+    return false;
+
+  if(m_Entries.size() >= MaxPickCacheEntries)
+  {
+    auto lru = m_Entries.end();
+    for(auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+    {
+      if(Atomic::CmpExch32(&(*it)->ready, 1, 1) != 1)
+        continue;
+
+      if(lru == m_Entries.end() || (*it)->lastUse < (*lru)->lastUse)
+        lru = it;
+    }
+
+    if(lru == m_Entries.end())
+      return false;
+
+    if((*lru)->thread)
+    {
+      Threading::JoinThread((*lru)->thread);
+      Threading::CloseThread((*lru)->thread);
+    }
+
+    delete *lru;
+    m_Entries.erase(lru);
+  }
+
+  entry = new Entry;
+  entry->key = key;
+  entry->lastUse = m_UseCounter;
+  entry->cfg = cfg;
+  entry->flipY = flipY;
+
+  // the driver can only be used on this thread, so fetch the data here
+  entry->source.driver = driver;
+  entry->source.CacheHighlightingData(eventId, cfg);
+  entry->source.driver = NULL;
+
+  m_Entries.push_back(entry);
+
+  if(cfg.position.numIndices <= SyncPickBuildIndices)
+  {
+    BuildEntry(entry);
+    entry->ready = 1;
+
+    vertid = entry->bvh.Pick(rayPos, rayDir);
+    return true;
+  }
+
+  entry->thread = Threading::CreateThread([entry]() {
+    BuildEntry(entry);
+    Atomic::CmpExch32(&entry->ready, 0, 1);
+  });
+
+  return false;
+}
+
 // colour ramp from http://www.ncl.ucar.edu/Document/Graphics/ColorTables/GMT_wysiwyg.shtml
 const Vec4f colorRamp[22] = {
     Vec4f(0.000000f, 0.000000f, 0.000000f, 0.0f), Vec4f(0.250980f, 0.000000f, 0.250980f, 1.0f),
@@ -28,6 +28,7 @@
 #include "api/replay/renderdoc_replay.h"
 #include "core/core.h"
 #include "maths/vec.h"
+#include "mesh_bvh.h"
 
 struct FrameRecord
 {
@@ -178,6 +179,8 @@ public:
   virtual DriverInformation GetDriverInfo() = 0;
 
   virtual rdcarray<GPUDevice> GetAvailableGPUs() = 0;
+
+  virtual InitialStateRestoreStats GetInitialStateRestoreStats() = 0;
 };
 
 class IReplayDriver : public IRemoteDriver
@@ -283,4 +286,46 @@ struct HighlightCache
                               const byte *end, bool useidx, bool &valid);
 };
 
+// cache of BVHs over recently picked triangle meshes, so hovering a mesh doesn't test every
+// triangle on each pick. Large meshes are built on a worker thread, and until that finishes the
+// caller falls back to picking on the GPU.
+struct MeshPickCache
+{
+  MeshPickCache() = default;
+  MeshPickCache(const MeshPickCache &) = delete;
+  MeshPickCache &operator=(const MeshPickCache &) = delete;
+  ~MeshPickCache() { Clear(); }
+  IRemoteDriver *driver = NULL;
+
+  // if a BVH for this mesh is ready, fills out vertid with the picked vertex (or ~0U on a miss) and
+  // returns true. Otherwise starts building one and returns false. flipY negates unprojected Y
+  // positions the way the Vulkan picking shader does.
+  bool PickTriangles(uint32_t eventId, const MeshDisplay &cfg, bool flipY, const Vec3f &rayPos,
+                     const Vec3f &rayDir, uint32_t &vertid);
+
+  void Clear();
+
+private:
+  struct Entry
+  {
+    uint64_t key = 0;
+    uint64_t lastUse = 0;
+    int32_t ready = 0;
+    int32_t cancel = 0;
+    Threading::ThreadHandle thread = 0;
+
+    // source data, only held until the BVH is built
+    MeshDisplay cfg;
+    bool flipY = false;
+    HighlightCache source;
+
+    MeshBVH bvh;
+  };
+
+  static void BuildEntry(Entry *entry);
+
+  std::vector<Entry *> m_Entries;
+  uint64_t m_UseCounter = 0;
+};
+
 extern const Vec4f colorRamp[22];
\ No newline at end of file
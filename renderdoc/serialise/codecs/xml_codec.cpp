@@ -997,4 +997,66 @@ static ConversionRegistration XMLOnlyConversionRegistration(
         R"(Stores the structured data in an xml tree, with large buffer data omitted - that makes it
 easier to work with but it cannot then be imported.)",
         false,
-    });
\ No newline at end of file
+    });
+#if ENABLED(ENABLE_UNIT_TESTS)
+
+#include "common/benchmark.h"
+
+TEST_CASE("Benchmark XML export and import", "[xml][!benchmark]")
+{
+  const uint32_t numChunks = 2000;
+
+  // chunks shaped like a typical draw - some IDs, plain values and a struct array
+  SDFile structData;
+  for(uint32_t i = 0; i < numChunks; i++)
+  {
+    SDChunk *chunk = new SDChunk("vkCmdDrawIndexed");
+    chunk->metadata.chunkID = 1000 + (i % 16);
+
+    chunk->data.children.push_back(makeSDObject("commandBuffer", ResourceId()));
+    chunk->data.children.push_back(makeSDObject("indexCount", i * 3));
+    chunk->data.children.push_back(makeSDObject("instanceCount", 1U));
+    chunk->data.children.push_back(makeSDObject("firstIndex", 0U));
+    chunk->data.children.push_back(makeSDObject("vertexOffset", int32_t(-1)));
+
+    SDObject *viewports = makeSDArray("pViewports");
+    for(uint32_t v = 0; v < 4; v++)
+    {
+      SDObject *viewport = makeSDStruct("$el", "VkViewport");
+      viewport->data.children.push_back(makeSDObject("x", 0.0f));
+      viewport->data.children.push_back(makeSDObject("y", 0.0f));
+      viewport->data.children.push_back(makeSDObject("width", 1920.0f));
+      viewport->data.children.push_back(makeSDObject("height", 1080.0f));
+      viewports->data.children.push_back(viewport);
+    }
+    chunk->data.children.push_back(viewports);
+
+    structData.chunks.push_back(chunk);
+  }
+
+  RDCFile rdc;
+  rdc.SetData(RDCDriver::Vulkan, "Vulkan", 0, NULL);
+
+  std::string filename = FileIO::GetTempFolderFilename() + "renderdoc_xml_benchmark.xml";
+
+  RunBenchmark("XML export 2000 chunks", 0,
+               [&]() { exportXMLOnly(filename.c_str(), rdc, structData, NULL); });
+
+  FILE *f = FileIO::fopen(filename.c_str(), "rb");
+  REQUIRE(f);
+  FileIO::fseek64(f, 0, SEEK_END);
+  uint64_t fileSize = FileIO::ftell64(f);
+  FileIO::fclose(f);
+
+  RunBenchmark("XML import 2000 chunks", fileSize, [&]() {
+    StreamReader reader(FileIO::fopen(filename.c_str(), "rb"));
+    RDCFile imported;
+    SDFile importedData;
+    importXMLZ(NULL, reader, &imported, importedData, NULL);
+    BenchmarkKeep(importedData.chunks.size());
+  });
+
+  FileIO::Delete(filename.c_str());
+}
+
+#endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -29,6 +29,7 @@
 #if ENABLED(ENABLE_UNIT_TESTS)
 
 #include "3rdparty/catch/catch.hpp"
+#include "common/benchmark.h"
 
 TEST_CASE("Test LZ4 compression/decompression", "[streamio][lz4]")
 {
@@ -190,4 +191,158 @@ TEST_CASE("Test ZSTD compression/decompression", "[streamio][zstd]")
   delete[] randomData;
 };
 
+// a mix of the kind of data captures contain - cleared memory, index-like runs, vertex-like floats
+// and incompressible texture data
+static std::vector<byte> MakeBenchmarkData()
+{
+  const size_t blockSize = 1024 * 1024;
+
+  std::vector<byte> ret(blockSize * 4);
+
+  byte *zeros = ret.data();
+  uint32_t *indices = (uint32_t *)(ret.data() + blockSize);
+  float *verts = (float *)(ret.data() + blockSize * 2);
+  byte *noise = ret.data() + blockSize * 3;
+
+  memset(zeros, 0, blockSize);
+
+  for(size_t i = 0; i < blockSize / sizeof(uint32_t); i++)
+    indices[i] = uint32_t(i / 6 * 4 + (i % 6 < 3 ? i % 6 : (i % 6) - 2));
+
+  for(size_t i = 0; i < blockSize / sizeof(float); i++)
+    verts[i] = float(i % 97) * 0.25f - float(i / 97) * 0.001f;
+
+  uint32_t state = 12345;
+  for(size_t i = 0; i < blockSize; i++)
+  {
+    state = state * 1664525U + 1013904223U;
+    noise[i] = byte(state >> 24);
+  }
+
+  return ret;
+}
+
+template <typename CompressorType, typename DecompressorType>
+static void BenchmarkCompression(const char *compressName, const char *decompressName)
+{
+  std::vector<byte> data = MakeBenchmarkData();
+
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  auto compress = [&]() {
+    buf.Rewind();
+    StreamWriter writer(new CompressorType(&buf, Ownership::Nothing), Ownership::Stream);
+    writer.Write(data.data(), data.size());
+    writer.Finish();
+  };
+
+  compress();
+
+  RunBenchmark(compressName, data.size(), compress);
+
+  std::vector<byte> readData(data.size());
+
+  RunBenchmark(decompressName, data.size(), [&]() {
+    StreamReader reader(
+        new DecompressorType(new StreamReader(buf.GetData(), buf.GetOffset()), Ownership::Stream),
+        data.size(), Ownership::Stream);
+    reader.Read(readData.data(), readData.size());
+  });
+
+  CHECK(readData == data);
+}
+
+template <typename CompressorType, typename DecompressorType>
+static void CheckReadAhead()
+{
+  // several times larger than the read-ahead ring, so that it wraps around
+  std::vector<byte> block = MakeBenchmarkData();
+  std::vector<byte> data;
+  for(int i = 0; i < 5; i++)
+    data.insert(data.end(), block.begin(), block.end());
+
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  {
+    StreamWriter writer(new CompressorType(&buf, Ownership::Nothing), Ownership::Stream);
+    writer.Write(data.data(), data.size());
+    writer.Finish();
+  }
+
+  auto makeReader = [&](uint64_t compressedSize) {
+    Decompressor *decompressor =
+        new DecompressorType(new StreamReader(buf.GetData(), compressedSize), Ownership::Stream);
+    return new StreamReader(new ReadAheadDecompressor(decompressor, data.size()), data.size(),
+                            Ownership::Stream);
+  };
+
+  SECTION("Reads match the source data")
+  {
+    StreamReader *reader = makeReader(buf.GetOffset());
+
+    // a mix of sizes so that reads straddle the block boundaries
+    std::vector<byte> readData(data.size());
+    const uint64_t sizes[] = {1, 7, 4096, 123457, 1024 * 1024 + 3, 16};
+
+    uint64_t offs = 0;
+    for(size_t i = 0; offs < data.size(); i++)
+    {
+      uint64_t size = RDCMIN(sizes[i % ARRAY_COUNT(sizes)], data.size() - offs);
+      reader->Read(readData.data() + offs, size);
+      offs += size;
+    }
+
+    CHECK_FALSE(reader->IsErrored());
+    CHECK(reader->AtEnd());
+    CHECK(readData == data);
+
+    delete reader;
+  };
+
+  SECTION("Reader can stop early")
+  {
+    StreamReader *reader = makeReader(buf.GetOffset());
+
+    std::vector<byte> readData(1000);
+    reader->Read(readData.data(), readData.size());
+
+    CHECK(memcmp(readData.data(), data.data(), readData.size()) == 0);
+
+    // must not wait for the thread to decompress the rest
+    delete reader;
+  };
+
+  SECTION("Truncated data fails")
+  {
+    StreamReader *reader = makeReader(buf.GetOffset() / 2);
+
+    std::vector<byte> readData(data.size());
+    reader->Read(readData.data(), readData.size());
+
+    CHECK(reader->IsErrored());
+
+    delete reader;
+  };
+}
+
+TEST_CASE("Test read-ahead decompression", "[streamio]")
+{
+  SECTION("LZ4")
+  {
+    CheckReadAhead<LZ4Compressor, LZ4Decompressor>();
+  };
+
+  SECTION("ZSTD")
+  {
+    CheckReadAhead<ZSTDCompressor, ZSTDDecompressor>();
+  };
+}
+
+TEST_CASE("Benchmark compression", "[streamio][!benchmark]")
+{
+  BenchmarkCompression<LZ4Compressor, LZ4Decompressor>("LZ4 compress 4MB", "LZ4 decompress 4MB");
+  BenchmarkCompression<ZSTDCompressor, ZSTDDecompressor>("ZSTD compress 4MB",
+                                                         "ZSTD decompress 4MB");
+}
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
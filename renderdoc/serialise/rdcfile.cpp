@@ -131,6 +131,9 @@ bool is_exr_file(FILE *f)
 
 static const uint32_t MAGIC_HEADER = MAKE_FOURCC('R', 'D', 'O', 'C');
 
+// compressed sections at least this large are decompressed on a thread ahead of the reader
+static const uint64_t ReadAheadMinimumSize = 4 * 1024 * 1024;
+
 namespace
 {
 struct FileHeader
@@ -799,25 +802,47 @@ StreamReader *RDCFile::ReadSection(int index) const
 
   const SectionProperties &props = m_Sections[index];
   SectionLocation offsetSize = m_SectionLocations[index];
-  FileIO::fseek64(m_File, offsetSize.dataOffset, SEEK_SET);
 
-  StreamReader *fileReader = new StreamReader(m_File, offsetSize.diskLength, Ownership::Nothing);
+  const bool compressed =
+      bool(props.flags & (SectionFlags::LZ4Compressed | SectionFlags::ZstdCompressed));
 
-  StreamReader *compReader = NULL;
+  // large compressed sections - in practice the frame capture - are decompressed ahead of the
+  // reader on a thread, so that it overlaps with the reader's own work like creating resources.
+  // The thread gets its own file handle so that it doesn't interfere with other reads of the file.
+  FILE *readAheadFile = NULL;
+  if(compressed && props.uncompressedSize >= ReadAheadMinimumSize && !m_Filename.empty())
+    readAheadFile = FileIO::fopen(m_Filename.c_str(), "rb");
 
-  if(props.flags & SectionFlags::LZ4Compressed)
+  StreamReader *fileReader = NULL;
+
+  if(readAheadFile)
   {
-    // the user will delete the compressed reader, and then it will delete the compressor and the
-    // file reader
-    compReader = new StreamReader(new LZ4Decompressor(fileReader, Ownership::Stream),
-                                  props.uncompressedSize, Ownership::Stream);
+    FileIO::fseek64(readAheadFile, offsetSize.dataOffset, SEEK_SET);
+    fileReader = new StreamReader(readAheadFile, offsetSize.diskLength, Ownership::Stream);
   }
-  else if(props.flags & SectionFlags::ZstdCompressed)
+  else
   {
-    compReader = new StreamReader(new ZSTDDecompressor(fileReader, Ownership::Stream),
-                                  props.uncompressedSize, Ownership::Stream);
+    FileIO::fseek64(m_File, offsetSize.dataOffset, SEEK_SET);
+    fileReader = new StreamReader(m_File, offsetSize.diskLength, Ownership::Nothing);
   }
 
+  Decompressor *decompressor = NULL;
+
+  // the user will delete the compressed reader, and then it will delete the compressor and the
+  // file reader
+  if(props.flags & SectionFlags::LZ4Compressed)
+    decompressor = new LZ4Decompressor(fileReader, Ownership::Stream);
+  else if(props.flags & SectionFlags::ZstdCompressed)
+    decompressor = new ZSTDDecompressor(fileReader, Ownership::Stream);
+
+  if(decompressor && readAheadFile)
+    decompressor = new ReadAheadDecompressor(decompressor, props.uncompressedSize);
+
+  StreamReader *compReader = NULL;
+
+  if(decompressor)
+    compReader = new StreamReader(decompressor, props.uncompressedSize, Ownership::Stream);
+
   // if we're compressing return that writer, otherwise return the file writer directly
   return compReader ? compReader : fileReader;
 }
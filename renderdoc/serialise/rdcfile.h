@@ -85,6 +85,7 @@ public:
 
   ContainerError ErrorCode() const { return m_Error; }
   std::string ErrorString() const { return m_ErrorString; }
+  const std::string &GetFilename() const { return m_Filename; }
   RDCDriver GetDriver() const { return m_Driver; }
   const std::string &GetDriverName() const { return m_DriverName; }
   uint64_t GetMachineIdent() const { return m_MachineIdent; }
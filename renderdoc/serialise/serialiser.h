@@ -1729,6 +1729,7 @@ public:
   }
 
   byte *GetData() const { return m_Data; }
+  uint32_t GetLength() const { return m_Length; }
   Chunk *Duplicate()
   {
     Chunk *ret = new Chunk();
@@ -27,6 +27,7 @@
 #if ENABLED(ENABLE_UNIT_TESTS)
 
 #include "3rdparty/catch/catch.hpp"
+#include "common/benchmark.h"
 
 void WriteAllBasicTypes(WriteSerialiser &ser)
 {
@@ -1528,4 +1529,76 @@ TEST_CASE("Test stringification works as expected", "[tostr]")
   };
 };
 
+static const uint64_t BenchmarkContentsSize = 256;
+
+// roughly the shape of a typical driver chunk - some IDs and flags, a struct with variable-length
+// members and an inline data upload
+template <typename SerialiserType>
+static void SerialiseBenchmarkChunk(SerialiserType &ser, const void *contents)
+{
+  SERIALISE_ELEMENT_LOCAL(resourceId, uint64_t(0x1234));
+  SERIALISE_ELEMENT_LOCAL(flags, 7U);
+
+  struct2 state;
+  if(ser.IsWriting())
+  {
+    state.name = "A representative object name";
+    state.floats = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+    state.viewports.resize(4);
+  }
+
+  SERIALISE_ELEMENT(state);
+
+  SERIALISE_ELEMENT_LOCAL(bytesize, BenchmarkContentsSize);
+  SERIALISE_ELEMENT_ARRAY(contents, bytesize);
+}
+
+TEST_CASE("Benchmark serialiser", "[serialiser][!benchmark]")
+{
+  const int numChunks = 1000;
+
+  byte contents[BenchmarkContentsSize];
+  for(uint64_t i = 0; i < BenchmarkContentsSize; i++)
+    contents[i] = byte(i * 7);
+
+  StreamWriter buf(StreamWriter::DefaultScratchSize);
+
+  WriteSerialiser writeSer(&buf, Ownership::Nothing);
+
+  auto write = [&]() {
+    WriteSerialiser &ser = writeSer;
+    buf.Rewind();
+    for(int i = 0; i < numChunks; i++)
+    {
+      SCOPED_SERIALISE_CHUNK(5);
+      SerialiseBenchmarkChunk(ser, contents);
+    }
+  };
+
+  write();
+
+  const uint64_t size = buf.GetOffset();
+
+  RunBenchmark("Serialiser write 1000 chunks", size, write);
+
+  auto read = [&](bool structured) {
+    ReadSerialiser ser(new StreamReader(buf.GetData(), size), Ownership::Stream);
+
+    if(structured)
+      ser.ConfigureStructuredExport([](uint32_t) -> std::string { return "TestChunk"; }, true);
+
+    for(int i = 0; i < numChunks; i++)
+    {
+      ser.ReadChunk<uint32_t>();
+      SerialiseBenchmarkChunk(ser, NULL);
+      ser.EndChunk();
+    }
+
+    BenchmarkKeep(ser.GetReader()->GetOffset());
+  };
+
+  RunBenchmark("Serialiser read 1000 chunks", size, [&]() { read(false); });
+  RunBenchmark("Serialiser read 1000 chunks with structured export", size, [&]() { read(true); });
+}
+
 #endif    // ENABLED(ENABLE_UNIT_TESTS)
@@ -38,6 +38,162 @@ Decompressor::~Decompressor()
     delete m_Read;
 }
 
+static const uint64_t readAheadBlockSize = 1024 * 1024;
+
+ReadAheadDecompressor::ReadAheadDecompressor(Decompressor *decompressor, uint64_t uncompressedSize)
+    : Decompressor(NULL, Ownership::Nothing)
+{
+  m_Decompressor = decompressor;
+  m_Remaining = m_Unread = uncompressedSize;
+
+  for(uint32_t i = 0; i < NumBlocks; i++)
+    m_Blocks[i] = AllocAlignedBuffer(readAheadBlockSize);
+
+  m_Thread = Threading::CreateThread([this]() { DecompressThread(); });
+
+  // if we couldn't create a thread, decompress on demand instead
+  if(m_Thread == 0)
+    RDCWARN("Couldn't create read-ahead decompression thread");
+}
+
+ReadAheadDecompressor::~ReadAheadDecompressor()
+{
+  // the reader may stop before the end, so tell the thread not to wait for space
+  Atomic::Inc32(&m_Shutdown);
+
+  if(m_Thread)
+  {
+    Threading::JoinThread(m_Thread);
+    Threading::CloseThread(m_Thread);
+  }
+
+  for(uint32_t i = 0; i < NumBlocks; i++)
+    FreeAlignedBuffer(m_Blocks[i]);
+
+  delete m_Decompressor;
+}
+
+void ReadAheadDecompressor::DecompressThread()
+{
+  while(m_Remaining > 0)
+  {
+    // wait for the reader to free up a block. It's busy doing something else with the data so
+    // there's no hurry to wake up
+    while(m_Produced - m_Consumed >= (int32_t)NumBlocks && m_Shutdown == 0)
+      Threading::Sleep(1);
+
+    if(m_Shutdown)
+      return;
+
+    uint32_t idx = uint32_t(m_Produced) % NumBlocks;
+
+    uint64_t size = RDCMIN(readAheadBlockSize, m_Remaining);
+
+    // a zero-sized block tells the reader that decompression failed
+    if(!m_Decompressor->Read(m_Blocks[idx], size))
+    {
+      m_BlockSizes[idx] = 0;
+      m_Remaining = 0;
+    }
+    else
+    {
+      m_BlockSizes[idx] = size;
+      m_Remaining -= size;
+    }
+
+    Atomic::Inc32(&m_Produced);
+  }
+}
+
+bool ReadAheadDecompressor::NextBlock()
+{
+  if(m_HasBlock)
+  {
+    m_HasBlock = false;
+    Atomic::Inc32(&m_Consumed);
+  }
+
+  // every block up to the total size is produced eventually, unless there's an error
+  if(m_Errored || m_Unread == 0)
+    return false;
+
+  if(m_Thread == 0)
+  {
+    // no thread, so do the work it would have done inline
+    uint32_t idx = uint32_t(m_Consumed) % NumBlocks;
+    uint64_t size = RDCMIN(readAheadBlockSize, m_Remaining);
+    m_BlockSizes[idx] = m_Decompressor->Read(m_Blocks[idx], size) ? size : 0;
+    m_Remaining -= size;
+  }
+  else
+  {
+    // the reader is blocked on us here, so only yield while waiting
+    while(m_Produced == m_Consumed)
+      Threading::Sleep(0);
+  }
+
+  uint64_t size = m_BlockSizes[CurrentBlock()];
+
+  if(size == 0)
+  {
+    m_Errored = true;
+    return false;
+  }
+
+  m_Unread -= size;
+  m_HasBlock = true;
+  m_BlockOffset = 0;
+
+  return true;
+}
+
+bool ReadAheadDecompressor::Recompress(Compressor *comp)
+{
+  bool success = true;
+
+  // write whatever is left of the current block, then every block after it
+  if(m_HasBlock)
+  {
+    uint32_t idx = CurrentBlock();
+    success &= comp->Write(m_Blocks[idx] + m_BlockOffset, m_BlockSizes[idx] - m_BlockOffset);
+  }
+
+  while(success && NextBlock())
+  {
+    uint32_t idx = CurrentBlock();
+    success &= comp->Write(m_Blocks[idx], m_BlockSizes[idx]);
+  }
+  success &= comp->Finish();
+
+  return success && !m_Errored;
+}
+
+bool ReadAheadDecompressor::Read(void *data, uint64_t numBytes)
+{
+  byte *dst = (byte *)data;
+
+  while(numBytes > 0)
+  {
+    if(!m_HasBlock || m_BlockOffset >= m_BlockSizes[CurrentBlock()])
+    {
+      if(!NextBlock())
+        return false;
+    }
+
+    uint32_t idx = CurrentBlock();
+
+    uint64_t chunkSize = RDCMIN(numBytes, m_BlockSizes[idx] - m_BlockOffset);
+
+    memcpy(dst, m_Blocks[idx] + m_BlockOffset, (size_t)chunkSize);
+
+    dst += chunkSize;
+    numBytes -= chunkSize;
+    m_BlockOffset += chunkSize;
+  }
+
+  return true;
+}
+
 static const uint64_t initialBufferSize = 64 * 1024;
 const byte StreamWriter::empty[128] = {};
 
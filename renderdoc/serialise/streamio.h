@@ -66,6 +66,53 @@ protected:
   Ownership m_Ownership;
 };
 
+// Runs another decompressor on a background thread, a few blocks ahead of the reader, so that
+// decompressing overlaps with whatever the reading thread does with the data - e.g. creating
+// resources while loading a capture. Reads must be sequential and in total no more than
+// uncompressedSize, as with any decompressor. The wrapped decompressor is owned and deleted.
+class ReadAheadDecompressor : public Decompressor
+{
+public:
+  ReadAheadDecompressor(Decompressor *decompressor, uint64_t uncompressedSize);
+  ~ReadAheadDecompressor();
+
+  bool Recompress(Compressor *comp);
+  bool Read(void *data, uint64_t numBytes);
+
+private:
+  void DecompressThread();
+
+  // fetch the next decompressed block from the thread, waiting if necessary
+  bool NextBlock();
+  uint32_t CurrentBlock() const { return uint32_t(m_Consumed) % NumBlocks; }
+
+  static const uint32_t NumBlocks = 8;
+
+  Decompressor *m_Decompressor;
+  Threading::ThreadHandle m_Thread = 0;
+
+  byte *m_Blocks[NumBlocks] = {};
+  uint64_t m_BlockSizes[NumBlocks] = {};
+
+  // blocks are a ring, the thread fills block [m_Produced % NumBlocks] and the reader consumes
+  // block [m_Consumed % NumBlocks]. Only the thread increments m_Produced and only the reader
+  // increments m_Consumed.
+  volatile int32_t m_Produced = 0;
+  volatile int32_t m_Consumed = 0;
+  volatile int32_t m_Shutdown = 0;
+
+  // how many bytes are left to decompress. Only accessed on the thread, or by the reader if there
+  // is no thread
+  uint64_t m_Remaining = 0;
+
+  // only accessed by the reader. The block currently being read from is CurrentBlock(), if
+  // m_HasBlock is true, and m_Unread is how many bytes are in the blocks after it.
+  uint64_t m_BlockOffset = 0;
+  uint64_t m_Unread = 0;
+  bool m_HasBlock = false;
+  bool m_Errored = false;
+};
+
 class StreamReader
 {
 public:
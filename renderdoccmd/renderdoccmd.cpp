@@ -795,9 +795,9 @@ struct TestCommand : public Command
   {
     parser.set_footer(
 #if PYTHON_VERSION_MINOR > 0
-        "<unit|functional>"
+        "<unit|bench|functional>"
 #else
-        "<unit>"
+        "<unit|bench>"
 #endif
         " [... parameters to test framework ...]");
     parser.add("help", '\0', "print this message");
@@ -826,6 +826,21 @@ struct TestCommand : public Command
 
     if(mode == "unit")
       return RENDERDOC_RunUnitTests("renderdoccmd test unit", convertArgs(rest));
+
+    // benchmarks are unit tests that are hidden by default. Run them all unless specific tests
+    // were selected
+    if(mode == "bench")
+    {
+      bool hasTestSpec = false;
+      for(const std::string &arg : rest)
+        if(!arg.empty() && arg[0] != '-')
+          hasTestSpec = true;
+
+      if(!hasTestSpec)
+        rest.push_back("[!benchmark]");
+
+      return RENDERDOC_RunUnitTests("renderdoccmd test bench", convertArgs(rest));
+    }
 #if PYTHON_VERSION_MINOR > 0
     else if(mode == "functional")
       return RENDERDOC_RunFunctionalTests(PYTHON_VERSION_MINOR, convertArgs(rest));
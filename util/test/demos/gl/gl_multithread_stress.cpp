@@ -0,0 +1,223 @@
+/******************************************************************************
+ * The MIT License (MIT)
+ *
+ * Copyright (c) 2019 Baldur Karlsson
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ ******************************************************************************/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "gl_test.h"
+
+RD_TEST(GL_Multithread_Stress, OpenGLGraphicsTest)
+{
+  static constexpr const char *Description =
+      "Issues a stream of small uploads from several loader threads, each with a context shared "
+      "with the main context, while the main thread renders. Logs the GL call throughput once a "
+      "second so the cost of contention in the hooks can be measured, e.g. under llvmpipe.";
+
+  std::string common = R"EOSHADER(
+
+#version 420 core
+
+#define v2f v2f_block \
+{                     \
+	vec4 pos;           \
+	vec4 col;           \
+	vec4 uv;            \
+}
+
+)EOSHADER";
+
+  std::string vertex = R"EOSHADER(
+
+layout(location = 0) in vec3 Position;
+layout(location = 1) in vec4 Color;
+layout(location = 2) in vec2 UV;
+
+out v2f vertOut;
+
+void main()
+{
+	vertOut.pos = vec4(Position.xyz, 1);
+	gl_Position = vertOut.pos;
+	vertOut.col = Color;
+	vertOut.uv = vec4(UV.xy, 0, 1);
+}
+
+)EOSHADER";
+
+  std::string pixel = R"EOSHADER(
+
+in v2f vertIn;
+
+layout(location = 0, index = 0) out vec4 Color;
+
+void main()
+{
+	Color = vertIn.col;
+}
+
+)EOSHADER";
+
+  static const int numThreads = 4;
+  static const int texDim = 16;
+
+  int main()
+  {
+    // initialise, create window, create context, etc
+    if(!Init())
+      return 3;
+
+    GLuint vao = MakeVAO();
+    glBindVertexArray(vao);
+
+    GLuint vb = MakeBuffer();
+    glBindBuffer(GL_ARRAY_BUFFER, vb);
+    glBufferStorage(GL_ARRAY_BUFFER, sizeof(DefaultTri), DefaultTri, 0);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(DefaultA2V), (void *)(0));
+    glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, sizeof(DefaultA2V), (void *)(sizeof(Vec3f)));
+    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(DefaultA2V),
+                          (void *)(sizeof(Vec3f) + sizeof(Vec4f)));
+
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+
+    GLuint program = MakeProgram(common + vertex, common + pixel);
+
+    // windowing system calls from different threads aren't necessarily safe against each other, so
+    // anything that touches the window or context binding goes through this lock.
+    std::mutex windowLock;
+    std::atomic<bool> done(false);
+    std::atomic<uint64_t> numCalls(0);
+
+    std::vector<GraphicsWindow *> windows(numThreads);
+    std::vector<void *> contexts(numThreads);
+
+    for(int i = 0; i < numThreads; i++)
+    {
+      windows[i] = MakeWindow(32, 32, ("Loader #" + std::to_string(i)).c_str());
+      contexts[i] = MakeContext(windows[i], mainContext);
+    }
+
+    auto loaderThread = [&](int idx) {
+      {
+        std::lock_guard<std::mutex> lock(windowLock);
+        ActivateContext(windows[idx], contexts[idx]);
+      }
+
+      std::vector<uint32_t> data(texDim * texDim, 0xff00ff00 + idx);
+
+      GLuint buf = 0, tex = 0;
+
+      glGenBuffers(1, &buf);
+      glBindBuffer(GL_ARRAY_BUFFER, buf);
+      glBufferData(GL_ARRAY_BUFFER, data.size() * sizeof(uint32_t), NULL, GL_DYNAMIC_DRAW);
+
+      glGenTextures(1, &tex);
+      glBindTexture(GL_TEXTURE_2D, tex);
+      glTexStorage2D(GL_TEXTURE_2D, 1, GL_RGBA8, texDim, texDim);
+
+      while(!done)
+      {
+        const uint64_t batch = 256;
+
+        for(uint64_t i = 0; i < batch; i++)
+        {
+          data[i % data.size()]++;
+
+          glBindBuffer(GL_ARRAY_BUFFER, buf);
+          glBufferSubData(GL_ARRAY_BUFFER, 0, data.size() * sizeof(uint32_t), data.data());
+          glBindTexture(GL_TEXTURE_2D, tex);
+          glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texDim, texDim, GL_RGBA, GL_UNSIGNED_BYTE,
+                          data.data());
+        }
+
+        glFlush();
+
+        numCalls += batch * 4 + 1;
+      }
+
+      glDeleteBuffers(1, &buf);
+      glDeleteTextures(1, &tex);
+    };
+
+    std::vector<std::thread> threads(numThreads);
+
+    for(int i = 0; i < numThreads; i++)
+      threads[i] = std::thread(loaderThread, i);
+
+    auto lastReport = std::chrono::high_resolution_clock::now();
+
+    while(true)
+    {
+      {
+        std::lock_guard<std::mutex> lock(windowLock);
+        if(!Running())
+          break;
+      }
+
+      float col[] = {0.4f, 0.5f, 0.6f, 1.0f};
+      glClearBufferfv(GL_COLOR, 0, col);
+
+      glUseProgram(program);
+
+      glViewport(0, 0, GLsizei(screenWidth), GLsizei(screenHeight));
+
+      glDrawArrays(GL_TRIANGLES, 0, 3);
+
+      numCalls += 4;
+
+      auto now = std::chrono::high_resolution_clock::now();
+      double secs = std::chrono::duration<double>(now - lastReport).count();
+
+      if(secs >= 1.0)
+      {
+        TEST_LOG("%.1f k GL calls/sec across %d loader threads and the main thread",
+                 double(numCalls.exchange(0)) / (secs * 1000.0), numThreads);
+        lastReport = now;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(windowLock);
+        Present();
+      }
+    }
+
+    done = true;
+
+    for(int i = 0; i < numThreads; i++)
+      threads[i].join();
+
+    for(int i = 0; i < numThreads; i++)
+    {
+      DestroyContext(contexts[i]);
+      delete windows[i];
+    }
+
+    return 0;
+  }
+};
+
+REGISTER_TEST();
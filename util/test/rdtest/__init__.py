@@ -3,3 +3,4 @@ from .capture import *
 from .runner import *
 from .analyse import *
 from .testcase import *
+from .perf import *
@@ -0,0 +1,287 @@
+import os
+import json
+import time
+import subprocess
+import renderdoc as rd
+from . import util
+from . import analyse
+from . import capture
+from .logging import log, TestFailureException
+
+# Fraction a metric can regress by compared to the baseline before it's reported as a failure
+_perf_threshold = 0.25
+_perf_baseline = ''
+
+# Regressions smaller than these absolute amounts are ignored, as they are within the noise of
+# timing small demos on software rasterizers
+_noise_floor = {
+    'ms': 2.0,
+    'bytes': 64*1024,
+    'us_per_call': 2.0,
+}
+
+
+def set_perf_baseline(path: str):
+    global _perf_baseline
+    _perf_baseline = os.path.abspath(path) if path != '' else ''
+
+
+def set_perf_threshold(threshold: float):
+    global _perf_threshold
+    _perf_threshold = threshold
+
+
+def get_perf_baseline():
+    return _perf_baseline
+
+
+def get_perf_threshold():
+    return _perf_threshold
+
+
+class PerfTimer:
+    def __init__(self):
+        self._start = time.perf_counter()
+
+    def restart(self):
+        self._start = time.perf_counter()
+
+    def ms(self):
+        return (time.perf_counter() - self._start) * 1000.0
+
+
+class PerfResults:
+    """
+    Collects metrics for one capture. Each metric is named with a unit suffix - _ms, _bytes or
+    _us_per_call - which is used to pick the noise floor when comparing against a baseline.
+    """
+
+    def __init__(self, name: str):
+        self.name = name
+        self.metrics = {}
+        self._memory_base = rd.GetCurrentProcessMemoryUsage()
+        self._memory_peak = self._memory_base
+
+    def add(self, metric: str, value):
+        self.metrics[metric] = value
+        log.print("  {}: {}".format(metric, _format_value(metric, value)))
+
+    def sample_memory(self):
+        self._memory_peak = max(self._memory_peak, rd.GetCurrentProcessMemoryUsage())
+
+    def finish(self):
+        self.sample_memory()
+        self.add('replay_memory_peak_bytes', self._memory_peak - self._memory_base)
+        return self.metrics
+
+
+def _format_value(metric: str, value):
+    if metric.endswith('_bytes'):
+        return '{:.2f} MB'.format(value / (1024.0*1024.0))
+    if metric.endswith('_ms'):
+        return '{:.2f} ms'.format(value)
+    if metric.endswith('_us_per_call'):
+        return '{:.3f} us/call'.format(value)
+    return str(value)
+
+
+def _unit(metric: str):
+    for unit in _noise_floor:
+        if metric.endswith('_' + unit):
+            return unit
+    return None
+
+
+def time_demo_frames(args: list, frame_counts=(5, 55), inject=False):
+    """
+    Runs a demo to completion twice with different frame counts, and returns the time per frame in
+    milliseconds. Taking the difference between two runs cancels out startup and shutdown costs.
+    """
+    times = []
+
+    for frames in frame_counts:
+        cmdline = args + ['--frame-count', str(frames)]
+
+        timer = PerfTimer()
+
+        if inject:
+            res = rd.ExecuteAndInject(util.get_demos_binary(), '', ' '.join(cmdline), [],
+                                      util.get_tmp_path('perf_capture'), rd.GetDefaultCaptureOptions(), True)
+
+            if res.status != rd.ReplayStatus.Succeeded:
+                raise RuntimeError("Couldn't launch program: {}".format(str(res.status)))
+        else:
+            subprocess.run([util.get_demos_binary()] + cmdline, stdout=subprocess.DEVNULL,
+                           stderr=subprocess.DEVNULL, check=True)
+
+        times.append(timer.ms())
+
+    return max(0.0, (times[1] - times[0]) / (frame_counts[1] - frame_counts[0]))
+
+
+def capture_demo(args: list, results: PerfResults, timeout=60):
+    """
+    Runs a demo injected, triggers a capture once it's running and returns the capture path. The
+    time from triggering to the capture being written is recorded.
+    """
+    ident = capture.run_executable(util.get_demos_binary(), ' '.join(args + ['--frame-count', '100000']),
+                                   cappath=util.get_tmp_path('perf_capture'))
+
+    control = capture.TargetControl(ident, timeout=timeout)
+
+    # Let the demo get past any startup work before capturing
+    time.sleep(1.0)
+
+    timer = PerfTimer()
+
+    control.control.TriggerCapture(1)
+
+    path = None
+
+    while path is None and timer.ms() < timeout * 1000.0:
+        msg: rd.TargetControlMessage = control.control.ReceiveMessage(None)
+
+        if msg.type == rd.TargetControlMessageType.NewCapture:
+            path = msg.newCapture.path
+            results.add('capture_trigger_to_written_ms', timer.ms())
+        elif msg.type == rd.TargetControlMessageType.Disconnected or not control.control.Connected():
+            break
+
+    # Close the connection and kill the demo
+    control.run(keep_running=lambda c: False)
+
+    if path is None:
+        raise RuntimeError("No capture made")
+
+    return path
+
+
+def _event_list(draws, events: list):
+    for d in draws:
+        for e in d.events:
+            events.append(e.eventId)
+        _event_list(d.children, events)
+
+
+def measure_capture_file(path: str, results: PerfResults):
+    """Records the size of each section and how long the file takes to open and load."""
+    timer = PerfTimer()
+
+    cap = rd.OpenCaptureFile()
+    status = cap.OpenFile(path, '', None)
+
+    if status != rd.ReplayStatus.Succeeded:
+        cap.Shutdown()
+        raise RuntimeError("Couldn't open '{}': {}".format(path, str(status)))
+
+    results.add('capture_open_file_ms', timer.ms())
+
+    results.add('capture_file_bytes', os.path.getsize(path))
+
+    for i in range(cap.GetSectionCount()):
+        props: rd.SectionProperties = cap.GetSectionProperties(i)
+        name = props.name.replace(' ', '_')
+        results.add('section_{}_compressed_bytes'.format(name), props.compressedSize)
+        results.add('section_{}_uncompressed_bytes'.format(name), props.uncompressedSize)
+
+    timer.restart()
+    sdfile: rd.SDFile = cap.GetStructuredData()
+    results.add('structured_data_load_ms', timer.ms())
+    results.add('structured_data_chunks', len(sdfile.chunks))
+    results.sample_memory()
+
+    del sdfile
+
+    if not cap.LocalReplaySupport():
+        cap.Shutdown()
+        raise RuntimeError("{} capture cannot be replayed".format(cap.DriverName()))
+
+    timer.restart()
+    controller = analyse.open_capture(cap=cap)
+    results.add('replay_open_ms', timer.ms())
+    results.sample_memory()
+
+    cap.Shutdown()
+
+    return controller
+
+
+def measure_replay(controller: rd.ReplayController, results: PerfResults):
+    """Records how long it takes to replay to the first, middle and last events of the frame."""
+    events = []
+    _event_list(controller.GetDrawcalls(), events)
+
+    if len(events) == 0:
+        return 0
+
+    # Go to the last event first, so that each replay after it has to go backwards and do a full
+    # replay from the start of the frame
+    for label, eid in [('last', events[-1]), ('first', events[0]), ('middle', events[len(events)//2])]:
+        timer = PerfTimer()
+        controller.SetFrameEvent(eid, True)
+        results.add('replay_{}_event_ms'.format(label), timer.ms())
+        results.sample_memory()
+
+    return len(events)
+
+
+def load_baseline():
+    if _perf_baseline == '' or not os.path.exists(_perf_baseline):
+        return {}
+
+    with open(_perf_baseline, 'r') as f:
+        return json.load(f)
+
+
+def write_results(all_results: dict):
+    out_path = util.get_artifact_path('perf_results.json')
+
+    with open(out_path, 'w') as f:
+        json.dump(all_results, f, indent=2, sort_keys=True)
+
+    log.print("Wrote performance results to {}".format(util.sanitise_filename(out_path)))
+
+
+def compare_to_baseline(all_results: dict, baseline: dict):
+    """Returns a list of human-readable regressions against the baseline."""
+    regressions = []
+
+    for name, metrics in all_results.items():
+        if name not in baseline:
+            log.print("No baseline for {}, not comparing".format(name))
+            continue
+
+        for metric, value in metrics.items():
+            unit = _unit(metric)
+            if unit is None or metric not in baseline[name]:
+                continue
+
+            ref = baseline[name][metric]
+
+            if value > ref * (1.0 + _perf_threshold) and value - ref > _noise_floor[unit]:
+                regressions.append("{} {} regressed: {} vs baseline {} (+{:.0f}%)"
+                                   .format(name, metric, _format_value(metric, value),
+                                           _format_value(metric, ref),
+                                           (value / ref - 1.0) * 100.0 if ref > 0 else 100.0))
+
+    return regressions
+
+
+def check_regressions(all_results: dict):
+    write_results(all_results)
+
+    baseline = load_baseline()
+
+    if len(baseline) == 0:
+        log.print("No performance baseline to compare against. Copy perf_results.json to use it as one.")
+        return
+
+    regressions = compare_to_baseline(all_results, baseline)
+
+    if len(regressions) > 0:
+        for r in regressions:
+            log.error(r)
+        raise TestFailureException("{} performance metrics regressed by more than {:.0f}%"
+                                   .format(len(regressions), _perf_threshold * 100.0))
+
+    log.success("No performance regressions compared to baseline")
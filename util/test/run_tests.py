@@ -30,6 +30,11 @@ parser.add_argument('--artifacts', default=os.path.join(script_dir, "artifacts")
                     help="The folder to put output artifacts in. Will be completely cleared.", type=str)
 parser.add_argument('--temp', default=os.path.join(script_dir, "tmp"),
                     help="The folder to put temporary run data in. Will be completely cleared.", type=str)
+parser.add_argument('--perf-baseline', default="",
+                    help="A perf_results.json from a previous run to compare performance tests against.", type=str)
+parser.add_argument('--perf-threshold', default=0.25,
+                    help="How much slower or larger a performance metric can be than the baseline, as a fraction.",
+                    type=float)
 parser.add_argument('--debugger',
                     help="Enable debugger mode, exceptions are not caught by the framework.", action="store_true")
 # Internal command, when we fork out to run a test in a separate process
@@ -103,6 +108,8 @@ rdtest.set_data_dir(data_path)
 rdtest.set_data_extra_dir(data_extra_path)
 rdtest.set_temp_dir(temp_path)
 rdtest.set_demos_binary(demos_binary)
+rdtest.set_perf_baseline(args.perf_baseline)
+rdtest.set_perf_threshold(args.perf_threshold)
 
 # debugger option implies in-process test running
 if args.debugger:
@@ -0,0 +1,75 @@
+import rdtest
+
+
+class Perf_Suite(rdtest.TestCase):
+    slow_test = True
+
+    # A spread of demos across the APIs, from a minimal frame to ones with many resources and calls.
+    # Any that aren't available on this platform or driver are skipped.
+    demos = [
+        'VK_Simple_Triangle',
+        'VK_CBuffer_Zoo',
+        'VK_Resource_Lifetimes',
+        'VK_Descriptor_Indexing',
+        'GL_Simple_Triangle',
+        'GL_CBuffer_Zoo',
+        'GL_Resource_Lifetimes',
+        'D3D11_Simple_Triangle',
+        'D3D11_CBuffer_Zoo',
+        'D3D11_Resource_Lifetimes',
+        'D3D12_Simple_Triangle',
+        'D3D12_CBuffer_Zoo',
+        'D3D12_Resource_Lifetimes',
+    ]
+
+    def measure_demo(self, name: str):
+        results = rdtest.PerfResults(name)
+
+        native_frame_ms = rdtest.time_demo_frames([name])
+        injected_frame_ms = rdtest.time_demo_frames([name], inject=True)
+
+        results.add('native_frame_ms', native_frame_ms)
+        results.add('injected_frame_ms', injected_frame_ms)
+
+        path = rdtest.capture_demo([name], results)
+
+        controller = rdtest.measure_capture_file(path, results)
+
+        num_events = rdtest.measure_replay(controller, results)
+
+        controller.Shutdown()
+
+        # Spread the per-frame overheads across the API calls in a frame. While idle every call is
+        # still intercepted for resource tracking, and while capturing it's also serialised.
+        if num_events > 0:
+            idle = max(0.0, injected_frame_ms - native_frame_ms)
+            capturing = max(0.0, results.metrics['capture_trigger_to_written_ms'] - injected_frame_ms)
+
+            results.add('frame_events', num_events)
+            results.add('idle_overhead_us_per_call', idle * 1000.0 / num_events)
+            results.add('capture_overhead_us_per_call', capturing * 1000.0 / num_events)
+
+        return results.finish()
+
+    def run(self):
+        all_results = {}
+
+        available = rdtest.fetch_tests()
+
+        for name in self.demos:
+            supported, reason = available.get(name, (False, 'not compiled'))
+
+            if not supported:
+                rdtest.log.print("Skipping {}: {}".format(name, reason))
+                continue
+
+            rdtest.log.print("Measuring {}".format(name))
+
+            all_results[name] = self.measure_demo(name)
+
+            rdtest.log.success("Measured {}".format(name))
+
+        if len(all_results) == 0:
+            raise rdtest.TestFailureException("No demos could be measured")
+
+        rdtest.check_regressions(all_results)